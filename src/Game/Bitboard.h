@@ -0,0 +1,319 @@
+#ifndef SENTE_BITBOARD_H
+#define SENTE_BITBOARD_H
+
+#include <array>
+#include <cstdint>
+#include <ciso646>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace sente {
+
+    /**
+     *
+     * counts the number of set bits in a word
+     *
+     * @param word word to count the bits of
+     * @return number of set bits
+     */
+    inline unsigned popCount(uint64_t word){
+#ifdef _MSC_VER
+        return unsigned(__popcnt64(word));
+#else
+        return unsigned(__builtin_popcountll(word));
+#endif
+    }
+
+    /**
+     *
+     * finds the index of the lowest set bit in a (non-zero) word
+     *
+     * @param word word to search
+     * @return index of the lowest set bit
+     */
+    inline unsigned lowestBit(uint64_t word){
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward64(&index, word);
+        return unsigned(index);
+#else
+        return unsigned(__builtin_ctzll(word));
+#endif
+    }
+
+    /**
+     *
+     * builds the words of a side x side board, optionally leaving out the points on the first or last row of the
+     * y axis (used to stop shifted points from wrapping onto the next column)
+     *
+     */
+    template<unsigned side>
+    constexpr std::array<uint64_t, (side * side + 63) / 64> makeRowMask(bool skipFirstRow, bool skipLastRow){
+        std::array<uint64_t, (side * side + 63) / 64> mask{};
+        for (unsigned index = 0; index < side * side; index++){
+            unsigned y = index % side;
+            if ((skipFirstRow and y == 0) or (skipLastRow and y == side - 1)){
+                continue;
+            }
+            mask[index / 64] |= uint64_t(1) << (index % 64);
+        }
+        return mask;
+    }
+
+    /**
+     *
+     * A set of points on a side x side board packed into 64-bit words.
+     *
+     * The point (x, y) is stored at bit x * side + y, so a shift by one moves a point along the y axis and a shift
+     * by side moves it along the x axis. This lets neighbor expansion, liberty counting and flood fills operate on
+     * a whole word of points at a time.
+     *
+     */
+    template<unsigned side>
+    class Bitboard {
+    public:
+
+        static constexpr unsigned points = side * side;
+        static constexpr unsigned words = (points + 63) / 64;
+
+        Bitboard() : bits{} {}
+
+        static unsigned toIndex(unsigned x, unsigned y){
+            return x * side + y;
+        }
+
+        static Bitboard fromIndex(unsigned index){
+            Bitboard result;
+            result.set(index);
+            return result;
+        }
+
+        static Bitboard full(){
+            Bitboard result;
+            result.bits = boardMask;
+            return result;
+        }
+
+        [[nodiscard]] bool test(unsigned index) const {
+            return (bits[index >> 6] >> (index & 63)) & 1;
+        }
+        void set(unsigned index){
+            bits[index >> 6] |= uint64_t(1) << (index & 63);
+        }
+        void reset(unsigned index){
+            bits[index >> 6] &= ~(uint64_t(1) << (index & 63));
+        }
+
+        [[nodiscard]] bool any() const {
+            for (unsigned i = 0; i < words; i++){
+                if (bits[i]){
+                    return true;
+                }
+            }
+            return false;
+        }
+        [[nodiscard]] bool none() const {
+            return not any();
+        }
+        [[nodiscard]] unsigned count() const {
+            unsigned total = 0;
+            for (unsigned i = 0; i < words; i++){
+                total += popCount(bits[i]);
+            }
+            return total;
+        }
+
+        /**
+         *
+         * obtains the index of the lowest point in the set (the set must not be empty)
+         *
+         * @return index of the first point in the set
+         */
+        [[nodiscard]] unsigned first() const {
+            unsigned i = 0;
+            while (bits[i] == 0){
+                i++;
+            }
+            return i * 64 + lowestBit(bits[i]);
+        }
+
+        /**
+         *
+         * calls a function on the index of every point in the set in ascending order
+         *
+         * @param function function to call on each index
+         */
+        template<typename Function>
+        void forEach(Function function) const {
+            for (unsigned i = 0; i < words; i++){
+                uint64_t word = bits[i];
+                while (word){
+                    function(i * 64 + lowestBit(word));
+                    word &= word - 1;
+                }
+            }
+        }
+
+        Bitboard operator&(const Bitboard& other) const {
+            Bitboard result;
+            for (unsigned i = 0; i < words; i++){
+                result.bits[i] = bits[i] & other.bits[i];
+            }
+            return result;
+        }
+        Bitboard operator|(const Bitboard& other) const {
+            Bitboard result;
+            for (unsigned i = 0; i < words; i++){
+                result.bits[i] = bits[i] | other.bits[i];
+            }
+            return result;
+        }
+        Bitboard operator^(const Bitboard& other) const {
+            Bitboard result;
+            for (unsigned i = 0; i < words; i++){
+                result.bits[i] = bits[i] ^ other.bits[i];
+            }
+            return result;
+        }
+        Bitboard operator~() const {
+            Bitboard result;
+            for (unsigned i = 0; i < words; i++){
+                result.bits[i] = ~bits[i] & boardMask[i];
+            }
+            return result;
+        }
+        Bitboard& operator&=(const Bitboard& other){
+            for (unsigned i = 0; i < words; i++){
+                bits[i] &= other.bits[i];
+            }
+            return *this;
+        }
+        Bitboard& operator|=(const Bitboard& other){
+            for (unsigned i = 0; i < words; i++){
+                bits[i] |= other.bits[i];
+            }
+            return *this;
+        }
+        Bitboard& operator^=(const Bitboard& other){
+            for (unsigned i = 0; i < words; i++){
+                bits[i] ^= other.bits[i];
+            }
+            return *this;
+        }
+
+        /**
+         *
+         * removes the points of another set from this set
+         *
+         * @param other points to remove
+         * @return the points of this set that are not in the other set
+         */
+        [[nodiscard]] Bitboard without(const Bitboard& other) const {
+            Bitboard result;
+            for (unsigned i = 0; i < words; i++){
+                result.bits[i] = bits[i] & ~other.bits[i];
+            }
+            return result;
+        }
+
+        bool operator==(const Bitboard& other) const {
+            return bits == other.bits;
+        }
+        bool operator!=(const Bitboard& other) const {
+            return bits != other.bits;
+        }
+
+        /**
+         *
+         * obtains the points that are orthogonally adjacent to at least one point in the set
+         *
+         * @return set of neighboring points
+         */
+        [[nodiscard]] Bitboard neighbors() const {
+
+            Bitboard result;
+
+            // shifting by one moves along the y axis, so mask out anything that wrapped onto another column
+            shiftUp(1, result.bits, notFirstRow);
+            shiftDown(1, result.bits, notLastRow);
+
+            // shifting by the side moves along the x axis, only the upper edge of the board needs to be masked
+            shiftUp(side, result.bits, boardMask);
+            shiftDown(side, result.bits, boardMask);
+
+            return result;
+        }
+
+        /**
+         *
+         * grows the set through all the connected points of a mask
+         *
+         * @param mask points that the set may grow into
+         * @return every point of the mask that is connected to the set
+         */
+        [[nodiscard]] Bitboard floodFill(const Bitboard& mask) const {
+
+            Bitboard region = *this & mask;
+            Bitboard frontier = region;
+
+            while (frontier.any()){
+                // only the newly added points can reach anything we haven't seen yet
+                frontier = frontier.neighbors() & mask;
+                frontier = frontier.without(region);
+                region |= frontier;
+            }
+
+            return region;
+        }
+
+        [[nodiscard]] uint64_t getWord(unsigned i) const {
+            return bits[i];
+        }
+
+    private:
+
+        std::array<uint64_t, words> bits;
+
+        typedef std::array<uint64_t, words> Words;
+
+        /**
+         *
+         * ors this set shifted towards higher indices into a result, masked by a given set of words
+         *
+         */
+        void shiftUp(unsigned shift, Words& result, const Words& mask) const {
+            for (unsigned i = words; i-- > 0;){
+                uint64_t word = bits[i] << shift;
+                if (i > 0){
+                    word |= bits[i - 1] >> (64 - shift);
+                }
+                result[i] |= word & mask[i];
+            }
+        }
+
+        /**
+         *
+         * ors this set shifted towards lower indices into a result, masked by a given set of words
+         *
+         */
+        void shiftDown(unsigned shift, Words& result, const Words& mask) const {
+            for (unsigned i = 0; i < words; i++){
+                uint64_t word = bits[i] >> shift;
+                if (i + 1 < words){
+                    word |= bits[i + 1] << (64 - shift);
+                }
+                result[i] |= word & mask[i];
+            }
+        }
+
+        static constexpr Words boardMask = makeRowMask<side>(false, false);
+        static constexpr Words notFirstRow = makeRowMask<side>(true, false);
+        static constexpr Words notLastRow = makeRowMask<side>(false, true);
+
+    };
+
+}
+
+#endif //SENTE_BITBOARD_H
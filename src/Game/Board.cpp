@@ -8,18 +8,34 @@
 
 namespace sente {
 
-    template<>
-    bool Board<19>::isStar(unsigned int x, unsigned int y) const {
-        return (x == 3 or x == 9 or x == 15) and (y == 3 or y == 9 or y == 15);
-    }
+    /**
+     *
+     * determines whether a point is a star point (hoshi). Boards of 13x13 and up place the corner stars on the 4-4
+     * point, boards of 7x7 and up on the 3-3 point. Odd boards get a star in the center, and odd boards of 15x15 and up
+     * also get stars on the middle of each side
+     *
+     * @param side length of the side of the board
+     * @param x x co-ordinate of the point
+     * @param y y co-ordinate of the point
+     * @return whether the point is a star point
+     */
+    bool isStarPoint(unsigned side, unsigned x, unsigned y){
 
-    template<>
-    bool Board<13>::isStar(unsigned x, unsigned y) const {
-        return ((x == 3 or x == 9) and (y == 3 or y == 9)) or (x == 6 and y == 6);
-    }
+        bool odd = side % 2 == 1;
+        unsigned center = side / 2;
+
+        if (side < 7){
+            return odd and x == center and y == center;
+        }
 
-    template<>
-    bool Board<9>::isStar(unsigned x, unsigned y) const {
-        return ((x == 2 or x == 6) and (y == 2 or y == 6)) or (x == 4 and y == 4);
+        unsigned edge = side >= 13 ? 3 : 2;
+
+        auto isLine = [&](unsigned coordinate){
+            return coordinate == edge or coordinate == side - 1 - edge or
+                   (odd and side >= 15 and coordinate == center);
+        };
+
+        return (isLine(x) and isLine(y)) or (odd and x == center and y == center);
     }
-}
\ No newline at end of file
+
+}
@@ -6,14 +6,18 @@
 #define SENTE_BOARD_H
 
 #include <array>
+#include <memory>
 #include <sstream>
 #include <ciso646>
 #include <iostream>
+#include <stdexcept>
+#include <type_traits>
 
 #include <pybind11/pybind11.h>
 #include <pybind11/numpy.h>
 
 #include "Move.h"
+#include "Bitboard.h"
 
 #ifdef __CYGWIN__
 #define WHITE_STONE " O "
@@ -29,6 +33,39 @@ namespace py = pybind11;
 
 namespace sente {
 
+    // smallest and largest board sizes that can be played on
+    constexpr unsigned MIN_BOARD_SIZE = 2;
+    constexpr unsigned MAX_BOARD_SIZE = 25;
+
+    bool isStarPoint(unsigned side, unsigned x, unsigned y);
+
+    /**
+     *
+     * calls a generic function with the size of a board as a compile time constant. Every supported size has its own
+     * instantiation, so the function body is fully specialized for whichever board it is called on
+     *
+     * @param side length of the side of the board
+     * @param function function to call with a std::integral_constant holding the size
+     * @return the result of the function
+     */
+    template<unsigned size = MIN_BOARD_SIZE, typename Function>
+    auto dispatchSide(unsigned side, Function&& function){
+        if constexpr (size < MAX_BOARD_SIZE){
+            if (side != size){
+                return dispatchSide<size + 1>(side, std::forward<Function>(function));
+            }
+        }
+        else {
+            if (side != size){
+                throw std::domain_error("Invalid Board size " + std::to_string(side) + " only sizes from " +
+                                        std::to_string(MIN_BOARD_SIZE) + "x" + std::to_string(MIN_BOARD_SIZE) + " to " +
+                                        std::to_string(MAX_BOARD_SIZE) + "x" + std::to_string(MAX_BOARD_SIZE) +
+                                        " are supported");
+            }
+        }
+        return function(std::integral_constant<unsigned, size>{});
+    }
+
     class _board {
     public:
 
@@ -47,8 +84,12 @@ namespace sente {
         virtual Stone getStone(unsigned x, unsigned y) const = 0;
         virtual Stone getStone(Vertex point) const = 0;
 
+        virtual unsigned countStones(Stone color) const = 0;
+
         virtual explicit operator std::string() const = 0;
 
+        [[nodiscard]] virtual std::unique_ptr<_board> clone() const = 0;
+
         void setUseASCII(bool useASCII) {
             this->useASCII = useASCII;
         }
@@ -75,25 +116,14 @@ namespace sente {
     public:
 
         Board(bool useASCII, bool lowerLeftOrigin) {
-
-            for (unsigned i = 0; i < side; i++){
-                for (unsigned j = 0; j < side; j++){
-                    board[i][j] = EMPTY;
-                }
-            }
-
             this->useASCII = useASCII;
             this->lowerLeftOrigin = lowerLeftOrigin;
-
         };
         ~Board() final = default;
 
         Board(const Board& other){
-            for (unsigned i = 0; i < side; i++){
-                for (unsigned j = 0; j < side; j++){
-                    board[i][j] = other.board[i][j];
-                }
-            }
+            blackStones = other.blackStones;
+            whiteStones = other.whiteStones;
             useASCII = other.useASCII;
             lowerLeftOrigin = other.lowerLeftOrigin;
         }
@@ -101,7 +131,7 @@ namespace sente {
         explicit Board(std::array<std::array<Stone, side>, side> stones){
             for (unsigned i = 0; i < side; i++){
                 for (unsigned j = 0; j < side; j++){
-                    board[i][j] = stones[i][j];
+                    setStone(Bitboard<side>::toIndex(i, j), stones[i][j]);
                 }
             }
             useASCII = false;
@@ -117,78 +147,90 @@ namespace sente {
         }
 
         void playStone(const Move& move) override{
-            board[move.getX()][move.getY()] = move.getStone();
+            setStone(Bitboard<side>::toIndex(move.getX(), move.getY()), move.getStone());
         }
 
         void captureStone(const Move& move) override{
-            board[move.getX()][move.getY()] = EMPTY;
+            setStone(Bitboard<side>::toIndex(move.getX(), move.getY()), EMPTY);
         }
 
-        [[nodiscard]] bool isStar(unsigned x, unsigned y) const;
+        /**
+         *
+         * removes every stone in a set of points from the board
+         *
+         * @param stones points to clear
+         */
+        void captureStones(const Bitboard<side>& stones){
+            blackStones = blackStones.without(stones);
+            whiteStones = whiteStones.without(stones);
+        }
+
+        [[nodiscard]] bool isStar(unsigned x, unsigned y) const {
+            return isStarPoint(side, x, y);
+        }
 
         [[nodiscard]] unsigned getSide() const override{
             return side;
         }
 
+        [[nodiscard]] std::unique_ptr<_board> clone() const override {
+            return std::make_unique<Board<side>>(*this);
+        }
+
         [[nodiscard]] Move getSpace(unsigned int x, unsigned int y) const override {
             if (not isOnBoard(Move(x, y, BLACK))){
                 throw std::out_of_range("Move not on board");
             }
-            return Move(x, y, board[x][y]);
+            return Move(x, y, getStone(x, y));
         }
         [[nodiscard]] Move getSpace(Vertex point) const override {
             return getSpace(point.getX(), point.getY());
         }
 
         [[nodiscard]] Stone getStone(unsigned x, unsigned y) const override {
-            return board[x][y];
+            return getStone(Bitboard<side>::toIndex(x, y));
+        }
+        [[nodiscard]] Stone getStone(unsigned index) const {
+            if (blackStones.test(index)){
+                return BLACK;
+            }
+            if (whiteStones.test(index)){
+                return WHITE;
+            }
+            return EMPTY;
         }
         [[nodiscard]] Stone getStone(Vertex point) const override {
             return getStone(point.getX(), point.getY());
         }
 
-        bool operator ==(const Board<side>& other) const {
-
-            for (unsigned i = 0; i < side; i++){
-                for (unsigned j = 0; j < side; j++){
-                    if (board[i][j] != other.board[i][j]){
-                        return false;
-                    }
-                }
-            }
-            return true;
+        [[nodiscard]] unsigned countStones(Stone color) const override {
+            return getStones(color).count();
         }
 
-
-        py::array_t<int8_t> numpy(){
-
-            // allocate the buffer and object
-            auto result = py::array_t<int8_t>(side * side);
-            auto buffer = result.request(true);
-
-            auto* ptr = (int8_t*) buffer.ptr;
-
-            for (unsigned i = 0; i < side; i++){
-                for (unsigned j = 0; j < side; j++){
-                    unsigned offset = j * side + i;
-                    switch (board[i][j]){
-                        case BLACK:
-                            ptr[offset] = 1;
-                            break;
-                        case WHITE:
-                            ptr[offset] = -1;
-                            break;
-                        case EMPTY:
-                            ptr[offset] = 0;
-                            break;
-                    }
-                }
+        /**
+         *
+         * obtains the bit-plane of all the points occupied by a given color
+         *
+         * @param color color of the stones (EMPTY gives the empty points)
+         * @return set of points containing the color
+         */
+        [[nodiscard]] Bitboard<side> getStones(Stone color) const {
+            switch (color){
+                case BLACK:
+                    return blackStones;
+                case WHITE:
+                    return whiteStones;
+                case EMPTY:
+                default:
+                    return getEmptyPoints();
             }
+        }
+        [[nodiscard]] Bitboard<side> getEmptyPoints() const {
+            return ~(blackStones | whiteStones);
+        }
 
-            result.resize({side, side});
-
-            return result;
-
+        bool operator ==(const Board<side>& other) const {
+            return blackStones == other.blackStones and whiteStones == other.whiteStones;
         }
 
         explicit operator std::string() const override{
@@ -208,7 +250,7 @@ namespace sente {
 
                 for (unsigned j = 0; j < side; j++){
 
-                    switch(board[j][i]){
+                    switch(getStone(j, i)){
                         case BLACK:
                             if (not useASCII){
                                 accumulator << " ⚫";
@@ -257,7 +299,25 @@ namespace sente {
         }
 
     private:
-        std::array<std::array<Stone, side>, side> board;
+
+        // one bit-plane per color
+        Bitboard<side> blackStones;
+        Bitboard<side> whiteStones;
+
+        void setStone(unsigned index, Stone stone){
+            blackStones.reset(index);
+            whiteStones.reset(index);
+            switch (stone){
+                case BLACK:
+                    blackStones.set(index);
+                    break;
+                case WHITE:
+                    whiteStones.set(index);
+                    break;
+                case EMPTY:
+                    break;
+            }
+        }
 
     };
 
@@ -0,0 +1,160 @@
+#ifndef SENTE_GAMESTATE_H
+#define SENTE_GAMESTATE_H
+
+#include <ciso646>
+
+#include "Board.h"
+#include "Bitboard.h"
+#include "GroupTable.h"
+#include "PointSet.h"
+
+namespace sente {
+
+    /**
+     *
+     * number of points each player owns on the board under area counting
+     *
+     */
+    struct AreaCount {
+        unsigned blackTerritory;
+        unsigned whiteTerritory;
+        unsigned blackStones;
+        unsigned whiteStones;
+    };
+
+    /**
+     *
+     * Statically sized view of the position of a game.
+     *
+     * GoGame stores its board behind the virtual _board interface so that it can hold a board of any size. The view
+     * resolves the size once, so the loops over every point of the board (legal move generation, counting and feature
+     * extraction) work directly on a Board<side> and its bit-planes without a virtual call per point.
+     *
+     */
+    template<unsigned side>
+    class GameState {
+    public:
+
+        GameState(const Board<side>& board, const GroupTable& groups) : board(board), groups(groups) {}
+
+        [[nodiscard]] const Board<side>& getBoard() const {
+            return board;
+        }
+
+        [[nodiscard]] const GroupTable& getGroups() const {
+            return groups;
+        }
+
+        /**
+         *
+         * determines whether a stone may be placed on a point under the basic rules of go (the point is empty, is not
+         * the ko point and the move is not a self-capture). Superko is left to the caller
+         *
+         * @param index point to play on
+         * @param color color of the stone to play
+         * @param koPoint move forbidden by the simple ko rule
+         * @param allowSelfCapture whether self-capture is legal (Tromp-Taylor rules)
+         * @return whether the move is legal
+         */
+        [[nodiscard]] bool isLegal(unsigned index, Stone color, const Move& koPoint, bool allowSelfCapture) const {
+
+            if (board.getStone(index) != EMPTY){
+                return false;
+            }
+            if (isKoPoint(index, color, koPoint)){
+                return false;
+            }
+
+            return allowSelfCapture or groups.getLegalPoints(color).contains(index);
+        }
+
+        /**
+         *
+         * calls a function on every point of the board that a stone may be placed on. The group table keeps the
+         * points that are not self-captures up to date, so only the ko point has to be checked here
+         *
+         * @param color color of the stone to play
+         * @param koPoint move forbidden by the simple ko rule
+         * @param allowSelfCapture whether self-capture is legal (Tromp-Taylor rules)
+         * @param function function to call with the index of each legal point
+         */
+        template<typename Function>
+        void forEachLegalPoint(Stone color, const Move& koPoint, bool allowSelfCapture, Function function) const {
+
+            auto visit = [&](unsigned index){
+                if (not isKoPoint(index, color, koPoint)){
+                    function(index);
+                }
+            };
+
+            if (allowSelfCapture){
+                board.getEmptyPoints().forEach(visit);
+            }
+            else {
+                groups.getLegalPoints(color).forEach(visit);
+            }
+        }
+
+        /**
+         *
+         * counts the stones of each player and the empty regions that only border one player. Rather than labeling
+         * each region, the empty points that can reach a stone of each color are found with one flood fill per color.
+         * Dead stones are taken off the board before counting
+         *
+         * @param deadStones stones to treat as captured
+         * @return the area of each player
+         */
+        [[nodiscard]] AreaCount countArea(const PointSet& deadStones = PointSet()) const {
+
+            Bitboard<side> dead;
+            deadStones.forEach([&](Point point){
+                dead.set(point);
+            });
+
+            auto black = board.getStones(BLACK).without(dead);
+            auto white = board.getStones(WHITE).without(dead);
+            auto empty = Bitboard<side>::full().without(black | white);
+
+            // a region borders a color exactly when one of its points is next to a stone of that color
+            auto reachesBlack = (black.neighbors() & empty).floodFill(empty);
+            auto reachesWhite = (white.neighbors() & empty).floodFill(empty);
+
+            return {reachesBlack.without(reachesWhite).count(), reachesWhite.without(reachesBlack).count(),
+                    black.count(), white.count()};
+        }
+
+        /**
+         *
+         * finds the points that a color owns under area scoring: its stones and the empty points that can only reach
+         * its stones
+         *
+         * @param color color to find the area of
+         * @return the points of the area
+         */
+        [[nodiscard]] Bitboard<side> getArea(Stone color) const {
+
+            auto empty = board.getEmptyPoints();
+            auto ours = board.getStones(color);
+            auto theirs = board.getStones(getOpponent(color));
+
+            auto reachesOurs = (ours.neighbors() & empty).floodFill(empty);
+            auto reachesTheirs = (theirs.neighbors() & empty).floodFill(empty);
+
+            return ours | reachesOurs.without(reachesTheirs);
+        }
+
+    private:
+
+        const Board<side>& board;
+        const GroupTable& groups;
+
+        [[nodiscard]] static bool isKoPoint(unsigned index, Stone color, const Move& koPoint) {
+            return koPoint.getStone() == color and koPoint.getX() < side and koPoint.getY() < side and
+                   index == Bitboard<side>::toIndex(koPoint.getX(), koPoint.getY());
+        }
+
+    };
+
+}
+
+#endif //SENTE_GAMESTATE_H
@@ -21,6 +21,38 @@ namespace sente {
         OTHER
     };
 
+    enum KoRule {
+        SIMPLE_KO,
+        POSITIONAL_SUPERKO,
+        SITUATIONAL_SUPERKO
+    };
+
+    /**
+     *
+     * result of checking a move against the rules. Every status other than LEGAL names the first rule the move breaks
+     *
+     */
+    enum MoveStatus {
+        LEGAL,
+        OFF_BOARD,
+        OCCUPIED_POINT,
+        WRONG_COLOR,
+        SELF_CAPTURE,
+        KO_POINT,
+        SUPERKO,
+        GAME_OVER
+    };
+
+    /**
+     *
+     * points of each player in a position, including komi
+     *
+     */
+    struct PositionScore {
+        double black;
+        double white;
+    };
+
     double determineKomi(Rules ruleset);
 
     Rules rulesFromStr(std::string ruleString);
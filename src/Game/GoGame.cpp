@@ -3,6 +3,7 @@
 //
 
 #include <stack>
+#include <cctype>
 #include <memory>
 #include <sstream>
 #include <iomanip>
@@ -11,6 +12,7 @@
 
 #include "GoGame.h"
 #include "LifeAndDeath.h"
+#include "Zobrist.h"
 #include "../Utils/SenteExceptions.h"
 
 namespace std {
@@ -28,7 +30,7 @@ namespace std {
 
 namespace sente {
 
-    GoGame::GoGame(unsigned side, Rules rules, double komi, std::unordered_set<Move> handicap) {
+    GoGame::GoGame(unsigned side, Rules rules, double komi, std::unordered_set<Move> handicap, KoRule koRule) {
 
         // default Komi values
         if (komi == INFINITY){
@@ -40,6 +42,12 @@ namespace sente {
 
         this->rules = rules;
 
+        // superko is only part of the rulesets that define it
+        if (koRule != SIMPLE_KO and not (rules == CHINESE or rules == TROMP_TAYLOR)){
+            throw std::domain_error("superko is only supported under Chinese and Tromp-Taylor rules");
+        }
+        this->koRule = koRule;
+
         makeBoard(side);
         resetKoPoint();
 
@@ -80,6 +88,10 @@ namespace sente {
         gameTree = utils::Tree<SGF::SGFNode>(rootNode);
         activeColor = getStartingColor();
 
+        // record the starting position
+        positionHistory.clear();
+        recordPosition();
+
     }
 
     GoGame::GoGame(utils::Tree<SGF::SGFNode> &SGFTree) {
@@ -121,6 +133,91 @@ namespace sente {
 
         activeColor = getStartingColor();
 
+        // record the starting position
+        positionHistory.clear();
+        recordPosition();
+
+    }
+
+    /**
+     *
+     * creates an independent copy of the game. A plain copy of a GoGame shares its board and game tree with the
+     * original, so anything that needs to branch off of a position (such as a search) should clone it instead
+     *
+     * @param keepHistory whether to copy the game tree and undo journal. Without the history, only the position is
+     * copied and the clone's game tree is a single root node that sets up the current stones, which makes the clone
+     * much cheaper to create
+     * @return copy of the game
+     */
+    GoGame GoGame::clone(bool keepHistory) const {
+
+        if (keepHistory){
+            GoGame copy(*this);
+            copy.board = copyBoard();
+            copy.gameTree = gameTree.deepCopy();
+            return copy;
+        }
+
+        GoGame copy;
+
+        copy.rules = rules;
+        copy.komi = komi;
+        copy.koRule = koRule;
+        copy.passCount = passCount;
+        copy.blackPoints = blackPoints;
+        copy.whitePoints = whitePoints;
+        copy.activeColor = activeColor;
+
+        copy.board = copyBoard();
+        copy.groups = groups;
+        copy.koPoint = koPoint;
+        copy.zobristHash = zobristHash;
+
+        copy.deadStones = deadStones;
+        copy.deadStonesHash = deadStonesHash;
+
+        // the root node of the clone sets up the current position
+        SGF::SGFNode rootNode = gameTree.getRoot();
+
+        std::unordered_set<Move> stones;
+        for (unsigned x = 0; x < getSide(); x++){
+            for (unsigned y = 0; y < getSide(); y++){
+                if (getSpace(x, y) != EMPTY){
+                    stones.emplace(x, y, getSpace(x, y));
+                }
+            }
+        }
+        rootNode.setAddedMoves(stones);
+
+        rootNode.setProperty(SGF::PL, {activeColor == BLACK ? "B" : "W"});
+        if (playoutResignation != EMPTY){
+            // the clone's playout can't be taken back, so its resignation becomes part of the game
+            rootNode.setProperty(SGF::RE, {playoutResignation == BLACK ? "W+R" : "B+R"});
+        }
+
+        copy.gameTree = utils::Tree<SGF::SGFNode>(rootNode);
+
+        // the captured stones can't be taken back from the clone, but they still count as prisoners
+        copy.earlierBlackCaptures = earlierBlackCaptures;
+        copy.earlierWhiteCaptures = earlierWhiteCaptures;
+        for (const auto& captured : capturedStones){
+            copy.earlierBlackCaptures += captured.black.size();
+            copy.earlierWhiteCaptures += captured.white.size();
+        }
+
+        // the journal can't be taken back past the new root, but the history features still need the last few moves
+        copy.earlierMoves = getRecentMoves(CLONE_HISTORY);
+        copy.earlierPositions = getRecentPositions(CLONE_HISTORY);
+
+        if (koRule == SIMPLE_KO){
+            // only superko needs to know about earlier positions
+            copy.recordPosition();
+        }
+        else {
+            copy.positionHistory = positionHistory;
+        }
+
+        return copy;
     }
 
     /**
@@ -135,23 +232,34 @@ namespace sente {
         // reset the tree to the root
         gameTree.advanceToRoot();
 
-        // set the groups and captures to be empty
-        groups = std::unordered_map<Move, std::shared_ptr<Group>>();
-        capturedStones = std::unordered_map<unsigned, std::unordered_set<Move>>();
+        // set the captures to be empty
+        capturedStones.clear();
+        undoJournal.clear();
+
+        // any playout is thrown away along with the moves in the tree
+        inPlayout = false;
+        playoutLength = 0;
+        playoutResignation = EMPTY;
 
         // set the points to be zero
         blackPoints = NAN;
         whitePoints = NAN;
 
-        // reset the ko point
         // reset the ko point
         resetKoPoint();
         passCount = 0;
 
+        // the new board is empty
+        zobristHash = 0;
+
         // add any stones at the root node
         addStones(gameTree.get().getAddedMoves());
 
         activeColor = getStartingColor();
+
+        // record the starting position
+        positionHistory.clear();
+        recordPosition();
 //        std::cout << "the starting color for this game is " << (activeColor == BLACK ? "Black" : "White") << std::endl;
 
     }
@@ -169,17 +277,14 @@ namespace sente {
         if (not board->isOnBoard(move)){
             return false;
         }
-        bool isEmpty = board->getStone(move.getVertex()) == EMPTY;
-        bool notSelfCapture = rules == TROMP_TAYLOR or isNotSelfCapture(move);
-        bool notKoPoint = isNotKoPoint(move);
-        bool correctColor = isCorrectColor(move);
 
-//        std::cout << "isEmpty: " << std::boolalpha << isEmpty << std::endl;
-//        std::cout << "notSelfCapture: " << std::boolalpha << notSelfCapture << std::endl;
-//        std::cout << "notKoPoint: " << std::boolalpha << notKoPoint << std::endl;
-//        std::cout << "correctColor: " << std::boolalpha << correctColor << std::endl;
+        bool legal = visitState([&](const auto& state){
+            return state.isLegal(groups.toIndex(move.getX(), move.getY()), move.getStone(), koPoint,
+                                 rules == TROMP_TAYLOR);
+        });
 
-        return isEmpty and notSelfCapture and notKoPoint and correctColor;
+        // the superko check is the most expensive so it only runs on moves that pass every other test
+        return legal and isCorrectColor(move) and isNotSuperko(move);
     }
 
     /**
@@ -194,11 +299,46 @@ namespace sente {
             return false;
         }
 
-        bool isEmpty = board->getStone(move.getVertex()) == EMPTY;
-        bool notSelfCapture = rules == TROMP_TAYLOR or isNotSelfCapture(move);
-        bool notKoPoint = isNotKoPoint(move);
+        bool legal = visitState([&](const auto& state){
+            return state.isLegal(groups.toIndex(move.getX(), move.getY()), move.getStone(), koPoint,
+                                 rules == TROMP_TAYLOR);
+        });
 
-        return isEmpty and notSelfCapture and notKoPoint;
+        return legal and isNotSuperko(move);
+    }
+
+    /**
+     *
+     * finds the first rule that a move breaks without throwing an exception. Passing and resigning are always legal
+     *
+     * @param move move to check
+     * @return LEGAL if the move may be played, otherwise the reason it may not
+     */
+    MoveStatus GoGame::getMoveStatus(const Move& move) {
+
+        if (move.isPass() or move.isResign()){
+            return LEGAL;
+        }
+        if (not board->isOnBoard(move)){
+            return OFF_BOARD;
+        }
+        if (board->getStone(move.getVertex()) != EMPTY){
+            return OCCUPIED_POINT;
+        }
+        if (not isCorrectColor(move)){
+            return WRONG_COLOR;
+        }
+        if (rules != TROMP_TAYLOR and not isNotSelfCapture(move)){
+            return SELF_CAPTURE;
+        }
+        if (not isNotKoPoint(move)){
+            return KO_POINT;
+        }
+        if (not isNotSuperko(move)){
+            return SUPERKO;
+        }
+
+        return LEGAL;
     }
 
     void GoGame::playStone(unsigned x, unsigned y){
@@ -216,66 +356,97 @@ namespace sente {
      * @param move move to play
      */
     void GoGame::playStone(const Move &move) {
+        MoveStatus status = tryPlay(move);
+        if (status != LEGAL){
+            throw utils::IllegalMoveException(status, move);
+        }
+    }
+
+    MoveStatus GoGame::tryPlay(unsigned x, unsigned y){
+        return tryPlay(Move(x, y, getActivePlayer()));
+    }
+
+    MoveStatus GoGame::tryPlay(unsigned x, unsigned y, Stone stone){
+        return tryPlay(Move(x, y, stone));
+    }
+
+    /**
+     *
+     * plays the specified move on the board if it is legal. Unlike playStone, an illegal move is reported through the
+     * return value rather than by throwing, which keeps rejected moves cheap
+     *
+     * @param move move to play
+     * @return LEGAL if the move was played, otherwise the rule the move breaks (the game is left unchanged)
+     */
+    MoveStatus GoGame::tryPlay(const Move &move) {
 
-        // create a new SGF node
-        SGF::SGFNode node(move);
+        // keep everything the move can overwrite so that it can be undone
+        UndoRecord record{move, 0, koPoint, passCount, activeColor, zobristHash, 0, blackPoints, whitePoints,
+                          playoutResignation};
 
         // check for pass/resign
         if (move.isPass()){
-            gameTree.insert(node);
-            if (++passCount >= 2){
-                // score the game
-                score();
+            if (inPlayout){
+                // playouts leave the game tree (and its result) alone
+                passCount++;
+                playoutLength++;
+            }
+            else {
+                SGF::SGFNode node(move);
+                gameTree.insert(node);
+                if (++passCount >= 2){
+                    // score the game
+                    score();
+                }
             }
             activeColor = getOpponent(activeColor);
-            return;
-        }
-        else {
-            passCount = 0;
+            recordPosition();
+            journalMove(record);
+            return LEGAL;
         }
 
         if (move.isResign()){
-            // get the root node
-            if (gameTree.getRoot().hasProperty(SGF::RE)){
-                // if the game has been resigned raise an exception
-                throw std::domain_error("Game cannot be forfeited; the game is already over");
+            // a game that is already over cannot be forfeited
+            if (isOver()){
+                return GAME_OVER;
+            }
+            passCount = 0;
+            if (inPlayout){
+                // the result is kept out of the game tree so that ending the playout takes the resignation back
+                playoutResignation = move.getStone();
+                playoutLength++;
+                recordPosition();
+                journalMove(record);
             }
             else {
                 gameTree.getRoot().setProperty(SGF::RE, {move.getStone() == BLACK ? "W+R" : "B+R"});
             }
-            return;
+            return LEGAL;
         }
 
-        // error handling
-        if (not isLegal(move)){
-            if (not board->isOnBoard(move)){
-                throw utils::IllegalMoveException(utils::OFF_BOARD, move);
-            }
-            if (board->getStone(move.getVertex()) != EMPTY){
-                throw utils::IllegalMoveException(utils::OCCUPIED_POINT, move);
-            }
-            if (not isCorrectColor(move)){
-                throw utils::IllegalMoveException(utils::WRONG_COLOR, move);
-            }
-            if (not isNotSelfCapture(move)){
-                throw utils::IllegalMoveException(utils::SELF_CAPTURE, move);
-            }
-            if (not isNotKoPoint(move)){
-                throw utils::IllegalMoveException(utils::KO_POINT, move);
-            }
+        MoveStatus status = getMoveStatus(move);
+        if (status != LEGAL){
+            return status;
         }
 
-        //        std::cout << "made it past isLegal" << std::endl;
+        passCount = 0;
 
         // place the stone on the board and record the move
         board->playStone(move);
-        gameTree.insert(node);
+        zobristHash ^= utils::getZobristKey(move);
+        if (inPlayout){
+            playoutLength++;
+        }
+        else {
+            SGF::SGFNode node(move);
+            gameTree.insert(node);
+        }
 
         // with the new stone placed on the board, update the internal board state
         updateBoard(move);
 
         // update the active color
-        if (gameTree.get().hasProperty(SGF::PL)){
+        if (not inPlayout and gameTree.get().hasProperty(SGF::PL)){
             // if we just set the player in this node, set the player
             switch (gameTree.get().getProperty(SGF::PL)[0][0]){
                 case 'B':
@@ -291,6 +462,10 @@ namespace sente {
             activeColor = getOpponent(activeColor);
         }
 
+        recordPosition();
+        journalMove(record);
+
+        return LEGAL;
     }
 
     /**
@@ -323,13 +498,17 @@ namespace sente {
      */
     void GoGame::addStones(const std::unordered_set<Move>& moves){
 
+        if (inPlayout){
+            throw std::domain_error("Stones cannot be added during a playout");
+        }
+
         // handle errors before moving forward
         for (const auto & move : moves){
             // error handling
             if (not isAddLegal(move)){
                 if (not board->isOnBoard(move)){
                     // aquire the GIL to throw an exception
-                    throw utils::IllegalMoveException(utils::OFF_BOARD, move);
+                    throw utils::IllegalMoveException(OFF_BOARD, move);
                 }
             }
         }
@@ -403,7 +582,9 @@ namespace sente {
             }
 
             // put the stone into the board and update the board
+            zobristHash ^= utils::getZobristKey(board->getSpace(move.getX(), move.getY()));
             board->playStone(move);
+            zobristHash ^= utils::getZobristKey(move);
             updateBoard(move);
         }
 
@@ -423,6 +604,8 @@ namespace sente {
                     break;
             }
         }
+
+        recordPosition();
     }
 
     void GoGame::setActivePlayer(Stone player) {
@@ -448,10 +631,31 @@ namespace sente {
             return;
         }
 
-        if (gameTree.getDepth() < steps){
+        if (getMoveNumber() < steps){
             throw std::domain_error("Cannot step up past root");
         }
 
+        bool undone = false;
+
+        // take back as many moves as the undo journal covers
+        while (steps > 0 and not undoJournal.empty() and undoJournal.back().depth == getMoveNumber()){
+            undoMove();
+            undone = true;
+            steps--;
+        }
+
+        if (undone){
+            // stones were removed without being captured, so chains may have split
+            groups.rebuild(*board);
+        }
+
+        if (steps == 0){
+            return;
+        }
+
+        // the remaining moves (such as add stone nodes) have to be reached by replaying the game
+        bool wasInPlayout = inPlayout;
+
         // get the moves that lead to this sequence
         std::vector<Playable> sequence = getMoveSequence();
 
@@ -465,6 +669,116 @@ namespace sente {
         // play out the move sequence without the last few moves
         playMoveSequence(sequence);
 
+        // a playout that was stepped out of is still running
+        inPlayout = wasInPlayout;
+
+    }
+
+    /**
+     *
+     * adds a move that was just played to the undo journal
+     *
+     * @param record state of the game from before the move
+     */
+    void GoGame::journalMove(UndoRecord record){
+        record.depth = getMoveNumber();
+        record.positionKey = getPositionKey(zobristHash, activeColor);
+        undoJournal.push_back(record);
+    }
+
+    /**
+     *
+     * takes back the last move in the undo journal. The group table is left for the caller to rebuild
+     *
+     */
+    void GoGame::undoMove(){
+
+        UndoRecord record = undoJournal.back();
+        undoJournal.pop_back();
+
+        // put back the captured stones before taking the move off, a Tromp-Taylor self-capture captures the move itself
+        if (record.depth < capturedStones.size()){
+
+            unsigned side = board->getSide();
+            auto& captured = capturedStones[record.depth];
+
+            captured.black.forEach([&](Point point){
+                board->playStone(Move(point / side, point % side, BLACK));
+            });
+            captured.white.forEach([&](Point point){
+                board->playStone(Move(point / side, point % side, WHITE));
+            });
+
+            captured = {};
+        }
+
+        if (not record.move.isPass() and not record.move.isResign()){
+            board->captureStone(record.move);
+        }
+
+        positionHistory.erase(positionHistory.find(record.positionKey));
+
+        koPoint = record.koPoint;
+        passCount = record.passCount;
+        activeColor = record.activeColor;
+        zobristHash = record.zobristHash;
+        blackPoints = record.blackPoints;
+        whitePoints = record.whitePoints;
+        playoutResignation = record.resigned;
+
+        if (playoutLength > 0){
+            playoutLength--;
+        }
+        else {
+            gameTree.stepUp();
+        }
+    }
+
+    /**
+     *
+     * starts a playout. Moves played during a playout update the board, captures, ko and superko like normal moves,
+     * but are not added to the game tree, which makes them much cheaper to play. A playout can be taken back with
+     * endPlayout() or added to the game tree as a variation with commitPlayout()
+     *
+     */
+    void GoGame::startPlayout(){
+        inPlayout = true;
+    }
+
+    /**
+     *
+     * takes back every move of the playout and returns to the position in the game tree that it started from
+     *
+     */
+    void GoGame::endPlayout(){
+        stepUp(playoutLength);
+        inPlayout = false;
+    }
+
+    /**
+     *
+     * adds the moves of the playout to the game tree as a variation of the position it started from. The game stays
+     * at the end of the new variation
+     *
+     */
+    void GoGame::commitPlayout(){
+
+        for (auto record = undoJournal.end() - playoutLength; record != undoJournal.end(); record++){
+            if (record->move.isResign()){
+                gameTree.getRoot().setProperty(SGF::RE, {record->move.getStone() == BLACK ? "W+R" : "B+R"});
+            }
+            else {
+                SGF::SGFNode node(record->move);
+                gameTree.insert(node);
+            }
+        }
+
+        playoutLength = 0;
+        inPlayout = false;
+    }
+
+    bool GoGame::isInPlayout() const {
+        return inPlayout;
     }
 
     void GoGame::playDefaultSequence(){
@@ -489,8 +803,8 @@ namespace sente {
 
     void GoGame::playMoveSequence(const std::vector<Playable>& moves) {
 
-        // obtain a backup of the move sequence
-        auto backupSequence = getMoveSequence();
+        // remember where we started so that we can get back to it
+        unsigned startingMove = getMoveNumber();
 
         try {
             for (const Playable& move : moves){
@@ -504,9 +818,8 @@ namespace sente {
         }
         catch (const utils::IllegalMoveException& except){
 
-            // if we hit an illegal move, reset the board and replay the sequence
-            resetBoard();
-            playMoveSequence(backupSequence);
+            // if we hit an illegal move, take back the moves that we managed to play
+            stepUp(getMoveNumber() - startingMove);
 
             // pass the exception back up the call tree
             throw except;
@@ -624,7 +937,87 @@ namespace sente {
     }
 
     unsigned GoGame::getMoveNumber() const {
-        return gameTree.getDepth();
+        return gameTree.getDepth() + playoutLength;
+    }
+
+    /**
+     *
+     * gets the last few moves played on the board (including passes and moves played during a playout), taken from
+     * the undo journal so that the game tree is not walked. Stones added to the board are not moves. A clone made
+     * without its history goes on to the last CLONE_HISTORY moves from before it was made
+     *
+     * @param count most moves to get
+     * @return the moves, starting with the most recent one
+     */
+    std::vector<Move> GoGame::getRecentMoves(unsigned count) const {
+
+        std::vector<Move> moves;
+
+        for (auto record = undoJournal.rbegin(); record != undoJournal.rend() and moves.size() < count; record++){
+            moves.push_back(record->move);
+        }
+
+        if (journalReachesRoot()){
+            for (auto move = earlierMoves.begin(); move != earlierMoves.end() and moves.size() < count; move++){
+                moves.push_back(*move);
+            }
+        }
+
+        return moves;
+    }
+
+    /**
+     *
+     * gets the stones on the board before each of the last few moves. Each position is found by taking back one more
+     * move from the undo journal (removing its stone and putting back whatever it captured), so no earlier position has
+     * to be stored or replayed
+     *
+     * @param count most positions to get
+     * @return the positions, starting with the one before the most recent move. There are fewer than count positions
+     * if fewer moves have been played since the board was set up (a clone without history goes on to the last
+     * CLONE_HISTORY positions from before it was made)
+     */
+    std::vector<StoneSets> GoGame::getRecentPositions(unsigned count) const {
+
+        std::vector<StoneSets> positions;
+
+        StoneSets position = visitState([](const auto& state){
+            return StoneSets{PointSet(state.getBoard().getStones(BLACK)), PointSet(state.getBoard().getStones(WHITE))};
+        });
+
+        for (auto record = undoJournal.rbegin(); record != undoJournal.rend() and positions.size() < count; record++){
+
+            // the captures go back first, a Tromp-Taylor self-capture captures the move itself
+            if (record->depth < capturedStones.size()){
+                position.black |= capturedStones[record->depth].black;
+                position.white |= capturedStones[record->depth].white;
+            }
+
+            if (not record->move.isPass()){
+                Point point = toPoint(record->move.getX(), record->move.getY(), getSide());
+                (record->move.getStone() == BLACK ? position.black : position.white).erase(point);
+            }
+
+            positions.push_back(position);
+        }
+
+        if (journalReachesRoot()){
+            for (auto earlier = earlierPositions.begin(); earlier != earlierPositions.end() and
+                                                          positions.size() < count; earlier++){
+                positions.push_back(*earlier);
+            }
+        }
+
+        return positions;
+    }
+
+    /**
+     *
+     * @return whether the undo journal covers every move since the root of the game tree, so that taking all of them
+     * back gives the position the game started from
+     */
+    bool GoGame::journalReachesRoot() const {
+        return undoJournal.size() == getMoveNumber();
     }
 
     utils::Tree<SGF::SGFNode> GoGame::getMoveTree() const {
@@ -716,24 +1109,7 @@ namespace sente {
     }
 
     std::unique_ptr<_board> GoGame::copyBoard() const {
-
-        std::unique_ptr<_board> newBoard;
-
-        switch (board->getSide()){
-            case 19:
-                newBoard = std::make_unique<Board<19>>(*((Board<19>*) board.get()));
-                break;
-            case 13:
-                newBoard =  std::make_unique<Board<13>>(*((Board<13>*) board.get()));
-                break;
-            case 9:
-                newBoard = std::make_unique<Board<9>>(*((Board<9>*) board.get()));
-                break;
-            default:
-                throw py::value_error("cannot construct board of size " + std::to_string(board->getSide()));
-        }
-
-        return newBoard;
+        return board->clone();
     }
 
     unsigned GoGame::getSide() const {
@@ -747,6 +1123,9 @@ namespace sente {
      * @return
      */
     sente::Stone GoGame::getWinner() const {
+        if (playoutResignation != EMPTY){
+            return getOpponent(playoutResignation);
+        }
         if (not gameTree.getRoot().hasProperty(SGF::RE)){
             // return an empty stone
             return EMPTY;
@@ -770,86 +1149,205 @@ namespace sente {
             throw std::domain_error("game did not end from passing; could not score");
         }
 
-        unsigned blackTerritory = 0;
-        unsigned whiteTerritory = 0;
+        PositionScore points = scorePosition();
+
+        blackPoints = points.black;
+        whitePoints = points.white;
+
+        std::stringstream results;
+
+        results << (blackPoints > whitePoints ? "B" : "W") << "+" << std::fixed << std::setprecision(1) << std::fabs(blackPoints - whitePoints);
+
+        // convert the result to a string
+        gameTree.getRoot().setProperty(SGF::RE, {results.str()});
+    }
+
+    /**
+     *
+     * scores the stones on the board as they are, so the game does not have to be over. Every stone on the board is
+     * counted as alive, which makes this suited to scoring the final positions of playouts
+     *
+     * @return the points of each player, including komi
+     */
+    PositionScore GoGame::scorePosition() const {
+
+        PointSet dead = getMarkedDeadStones();
+
+        AreaCount area = visitState([&](const auto& state){
+            return state.countArea(dead);
+        });
+
+        double blackScore = area.blackTerritory;
+        double whiteScore = area.whiteTerritory + komi;
+
+        if (rules == CHINESE or rules == TROMP_TAYLOR){
+            // area scoring gives a point for every stone on the board
+            blackScore += area.blackStones;
+            whiteScore += area.whiteStones;
+        }
+        else {
+            // for japanese rules, subtract a point for each captured stone
+            blackScore -= earlierBlackCaptures;
+            whiteScore -= earlierWhiteCaptures;
+            for (const auto& captured : capturedStones){
+                blackScore -= captured.black.size();
+                whiteScore -= captured.white.size();
+            }
+            // dead stones are taken off the board as prisoners
+            dead.forEach([&](Point point){
+                (groups.getStone(point) == BLACK ? blackScore : whiteScore) -= 1;
+            });
+        }
+
+        return {blackScore, whiteScore};
+    }
+
+    /**
+     *
+     * marks stones as dead so that scoring takes them off the board. The marks only apply to the current position
+     * and are ignored once the stones on the board change. If the game is already over it is scored again
+     *
+     * @param stones stones to mark as dead (replacing any earlier marks)
+     */
+    void GoGame::setDeadStones(const std::vector<Move>& stones){
+
+        PointSet marked;
 
-        unsigned blackStones = 0;
-        unsigned whiteStones = 0;
+        for (const auto& stone : stones){
+            if (getSpace(stone.getX(), stone.getY()) == EMPTY){
+                throw std::domain_error("cannot mark an empty point as dead");
+            }
+            marked.insert(groups.toIndex(stone.getX(), stone.getY()));
+        }
 
-        // TODO: add functionality to remove dead stones
+        deadStones = marked;
+        deadStonesHash = zobristHash;
 
-        // generate a list of all the regions in the board
-        auto regions = utils::getEmptySpaces(*board);
+        if (passCount >= 2 and not inPlayout){
+            score();
+        }
+    }
 
-        for (const auto& region : regions){
+    /**
+     *
+     * marks the stones in the territory recorded by the TB and TW properties of the current SGF node as dead
+     *
+     */
+    void GoGame::setDeadStonesFromTerritory(){
 
-            // go through all the adjacent groups
-            auto adjacentGroups = utils::getAdjacentGroups(region, *board, groups);
+        const SGF::SGFNode& node = gameTree.get();
+        unsigned side = board->getSide();
 
-            auto iter = adjacentGroups.begin();
+        std::vector<Move> dead;
 
-            if (iter != adjacentGroups.end()){
-                Stone firstColor = (*iter)->getColor();
+        auto markTerritory = [&](SGF::SGFProperty property, Stone owner){
+            if (not node.hasProperty(property)){
+                return;
+            }
+            for (const auto& value : node.getProperty(property)){
 
-                bool isTerritory = true;
+                // a list of points may be compressed into a rectangle such as "aa:cc"
+                bool isRectangle = value.size() == 5 and value[2] == ':';
 
-                for (iter++; iter != adjacentGroups.end(); iter++){
-                    if ((*iter)->getColor() != firstColor){
-                        isTerritory = false;
-                        break;
-                    }
+                if (not (value.size() == 2 or isRectangle) or not std::islower(value[0]) or not std::islower(value[1]) or
+                    (isRectangle and (not std::islower(value[3]) or not std::islower(value[4])))){
+                    throw utils::InvalidSGFException("invalid territory point \"" + value + "\"");
                 }
 
-                if (isTerritory){
-                    if (firstColor == BLACK){
-                        blackTerritory += region.size();
-                    }
-                    if (firstColor == WHITE){
-                        whiteTerritory += region.size();
+                unsigned firstX = value[0] - 'a';
+                unsigned firstY = value[1] - 'a';
+                unsigned lastX = isRectangle ? value[3] - 'a' : firstX;
+                unsigned lastY = isRectangle ? value[4] - 'a' : firstY;
+
+                for (unsigned x = firstX; x <= lastX and x < side; x++){
+                    for (unsigned y = firstY; y <= lastY and y < side; y++){
+                        // only the stones of the other player can be dead in a player's territory
+                        if (getSpace(x, y) == getOpponent(owner)){
+                            dead.emplace_back(x, y, getOpponent(owner));
+                        }
                     }
                 }
             }
+        };
 
-        }
+        markTerritory(SGF::TB, BLACK);
+        markTerritory(SGF::TW, WHITE);
 
-        if (rules == CHINESE){
-            // if we have chinese rules, we score a point for every stone we've played on the board
-            for (unsigned i = 0; i < board->getSide(); i++){
-                for (unsigned j = 0; j < board->getSide(); j++){
-                    if (board->getStone(i, j) == BLACK){
-                        blackStones++;
-                    }
-                    if (board->getStone(i, j) == WHITE){
-                        whiteStones++;
-                    }
+        setDeadStones(dead);
+    }
+
+    std::vector<Move> GoGame::getDeadStones() const {
+
+        unsigned side = board->getSide();
+        std::vector<Move> stones;
+
+        getMarkedDeadStones().forEach([&](Point point){
+            stones.emplace_back(point / side, point % side, groups.getStone(point));
+        });
+
+        return stones;
+    }
+
+    /**
+     *
+     * finds the stones that are certainly dead: the stones inside the pass-alive area of the other player. Stones
+     * that are only dead in practice are not found
+     *
+     * @return list of dead stones
+     */
+    std::vector<Move> GoGame::findDeadStones() const {
+
+        unsigned side = board->getSide();
+        std::vector<Move> stones;
+
+        for (Stone color : {BLACK, WHITE}){
+            utils::getPassAliveArea(*board, color).forEach([&](Point point){
+                if (groups.getStone(point) == getOpponent(color)){
+                    stones.emplace_back(point / side, point % side, getOpponent(color));
                 }
-            }
+            });
         }
-        else {
-            // for japanese rules, subtract a point for each captured stone
-            for (const auto& group : capturedStones){
-                if (group.second.begin()->getStone() == BLACK){
-                    blackTerritory -= group.second.size();
-                }
-                if (group.second.begin()->getStone() == WHITE){
-                    whiteTerritory -= group.second.size();
-                }
-            }
+
+        return stones;
+    }
+
+    /**
+     *
+     * finds the area that a player owns unconditionally (see utils::getPassAliveArea)
+     *
+     * @param color color of the player
+     * @return the points of the area, each as a move of the color
+     */
+    std::vector<Move> GoGame::getPassAliveArea(Stone color) const {
+
+        if (color == EMPTY){
+            throw std::domain_error("cannot find the area of an empty point");
         }
 
-        // compute the black and white raw scores
-        blackPoints = blackTerritory + blackStones;
-        whitePoints = whiteTerritory + whiteStones + komi;
+        unsigned side = board->getSide();
+        std::vector<Move> points;
 
-        std::stringstream results;
+        utils::getPassAliveArea(*board, color).forEach([&](Point point){
+            points.emplace_back(point / side, point % side, color);
+        });
 
-        results << (blackPoints > whitePoints ? "B" : "W") << "+" << std::fixed << std::setprecision(1) << std::fabs(blackPoints - whitePoints);
+        return points;
+    }
 
-        // convert the result to a string
-        gameTree.getRoot().setProperty(SGF::RE, {results.str()});
+    /**
+     *
+     * gets the stones that were marked as dead on the current position
+     *
+     * @return the marked stones, or an empty set if the stones on the board have changed since they were marked
+     */
+    PointSet GoGame::getMarkedDeadStones() const {
+        return deadStonesHash == zobristHash ? deadStones : PointSet();
     }
 
     std::string GoGame::getResult() const {
+        if (playoutResignation != EMPTY){
+            return playoutResignation == BLACK ? "W+R" : "B+R";
+        }
         if (isOver()){
             return getProperties().at("RE")[0];
         }
@@ -876,17 +1374,13 @@ namespace sente {
     std::vector<Move> GoGame::getLegalMoves() {
         py::gil_scoped_release release;
 
-        // go through the entire board
         Stone player = getActivePlayer();
+        unsigned side = board->getSide();
         std::vector<Move> moves;
 
-        for (unsigned i = 0; i < board->getSide(); i++){
-            for (unsigned j = 0; j < board->getSide(); j++){
-                if (isLegal(i, j)){
-                    moves.emplace_back(i, j, player);
-                }
-            }
-        }
+        getLegalPoints().forEach([&](Point point){
+            moves.emplace_back(point / side, point % side, player);
+        });
 
         // add resignation and passing
         moves.emplace_back(Move::pass(getActivePlayer()));
@@ -896,10 +1390,99 @@ namespace sente {
 
     }
 
+    /**
+     *
+     * gets the points that the active player can legally play on
+     *
+     * @return set of legal points, indexed x * side + y
+     */
+    PointSet GoGame::getLegalPoints() const {
+
+        Stone player = getActivePlayer();
+        PointSet legal;
+
+        // the group table keeps track of the points that are not self-captures
+        visitState([&](const auto& state){
+            unsigned side = state.getBoard().getSide();
+            state.forEachLegalPoint(player, koPoint, rules == TROMP_TAYLOR, [&](unsigned index){
+                if (isNotSuperko(Move(index / side, index % side, player))){
+                    legal.insert(index);
+                }
+            });
+        });
+
+        return legal;
+    }
+
+    /**
+     *
+     * fills a mask of the moves the active player can legally play. The mask has one byte for each point of the
+     * board in the order x * side + y followed by a byte for passing (which is always legal). The mask is kept inside
+     * the game so that it can be viewed without copying, and it is overwritten by the next call
+     *
+     * @return the legal move mask
+     */
+    const std::vector<uint8_t>& GoGame::getLegalMask() {
+
+        unsigned side = board->getSide();
+        PointSet legal = getLegalPoints();
+
+        // the mask only allocates the first time it is filled, so its storage stays in place
+        legalMask.resize(side * side + 1);
+
+        for (unsigned index = 0; index < side * side; index++){
+            legalMask[index] = legal.contains(index);
+        }
+        legalMask[side * side] = 1;
+
+        return legalMask;
+    }
+
     Vertex GoGame::getKoPoint() const {
         return {koPoint.getX(), koPoint.getY()};
     }
 
+    /**
+     *
+     * obtains the liberties of the chain of stones on a point
+     *
+     * @param x x co-ordinate of a stone in the chain
+     * @param y y co-ordinate of a stone in the chain
+     * @return the empty points adjacent to the chain
+     */
+    std::vector<Move> GoGame::getLiberties(unsigned x, unsigned y) const {
+
+        if (getSpace(x, y) == EMPTY){
+            throw std::domain_error("cannot get the liberties of an empty point");
+        }
+
+        unsigned side = board->getSide();
+        std::vector<Move> liberties;
+
+        groups.getLiberties(groups.toIndex(x, y)).forEach([&](Point point){
+            liberties.emplace_back(point / side, point % side, EMPTY);
+        });
+
+        return liberties;
+    }
+
+    /**
+     *
+     * counts the liberties of the chain of stones on a point
+     *
+     * @param x x co-ordinate of a stone in the chain
+     * @param y y co-ordinate of a stone in the chain
+     * @return the number of empty points adjacent to the chain
+     */
+    unsigned GoGame::countLiberties(unsigned x, unsigned y) const {
+
+        if (getSpace(x, y) == EMPTY){
+            throw std::domain_error("cannot get the liberties of an empty point");
+        }
+
+        return groups.countLiberties(groups.toIndex(x, y));
+    }
+
     std::string GoGame::getComment() const {
         if (gameTree.get().hasProperty(SGF::C)){
             return gameTree.get().getProperty(SGF::C)[0];
@@ -923,37 +1506,22 @@ namespace sente {
 
     void GoGame::makeBoard(unsigned int side) {
 
-        switch (side){
-            case 19:
-                board = std::make_shared<Board<19>>(false, false);
-                break;
-            case 13:
-                board = std::make_shared<Board<13>>(false, false);
-                break;
-            case 9:
-                board = std::make_shared<Board<9>>(false, false);
-                break;
-            default:
-                throw std::domain_error("Invalid Board size " +
-                                            std::to_string(side) + " only 9x9, 13x13 and 19x19 are currently supported");
-        }
+        board = dispatchSide(side, [](auto size) -> std::shared_ptr<_board> {
+            return std::make_shared<Board<decltype(size)::value>>(false, false);
+        });
+
+        groups = GroupTable(side);
     }
     void GoGame::clearBoard() {
 
-        switch (board->getSide()){
-            case 19:
-                board = std::make_shared<Board<19>>(board->getUseASCII(), board->getLowerLeftOrigin());
-                break;
-            case 13:
-                board = std::make_shared<Board<13>>(board->getUseASCII(), board->getLowerLeftOrigin());
-                break;
-            case 9:
-                board = std::make_shared<Board<9>>(board->getUseASCII(), board->getLowerLeftOrigin());
-                break;
-            default:
-                throw std::domain_error("Invalid Board size " +
-                                        std::to_string(board->getSide()) + " only 9x9, 13x13 and 19x19 are currently supported");
-        }
+        bool useASCII = board->getUseASCII();
+        bool lowerLeftOrigin = board->getLowerLeftOrigin();
+
+        board = dispatchSide(board->getSide(), [&](auto size) -> std::shared_ptr<_board> {
+            return std::make_shared<Board<decltype(size)::value>>(useASCII, lowerLeftOrigin);
+        });
+
+        groups.clear();
     }
 
     void GoGame::resetKoPoint(){
@@ -972,7 +1540,11 @@ namespace sente {
 
         bool whitesMoveFirst;
 
-        if (not gameTree.getRoot().getAddedMoves().empty()){
+        if (gameTree.getRoot().hasProperty(SGF::PL)){
+            // the root says who plays first
+            whitesMoveFirst = gameTree.getRoot().getProperty(SGF::PL)[0][0] == 'W';
+        }
+        else if (not gameTree.getRoot().getAddedMoves().empty()){
 
             unsigned blackStones = 0;
             unsigned whiteStones = 0;
@@ -1014,78 +1586,80 @@ namespace sente {
      */
     void GoGame::updateBoard(const Move& move) {
 
-        std::unordered_set<std::shared_ptr<Group>> ourAffectedGroups{};
-        std::unordered_set<std::shared_ptr<Group>> theirAffectedGroups{};
+        // reset the ko point
+        resetKoPoint();
 
-        // check to see if this move extends a group
-        for (const auto& adjacentSpace : move.getAdjacentMoves(board->getSide())) {
-            Move temp = board->getSpace(adjacentSpace);
-            if (groups.find(temp) != groups.end()) {
-                if (groups.at(temp)->getColor() == move.getStone()) {
-                    ourAffectedGroups.insert(groups.at(temp));
-                }
-                else if (groups.at(temp)->getColor() == getOpponent(move.getStone())){
-                    theirAffectedGroups.insert(groups.at(temp));
-                }
-            }
-        }
+        unsigned index = groups.toIndex(move.getX(), move.getY());
 
-        // connect stones
-        if (ourAffectedGroups.empty()){
-            // if we are not connected to any group, create a new group!
-            groups[move] = std::make_shared<Group>(move);
+        if (groups.getStone(index) != EMPTY){
+            // an added stone replaced or removed a stone, which may split its chain
+            groups.rebuild(*board);
         }
-        else {
-            // if we are connected to a group, connect our stones
-            connectGroups(move, ourAffectedGroups);
+        else if (move.getStone() != EMPTY){
+            groups.placeStone(index, move.getStone());
         }
 
-        // reset the ko point
-        resetKoPoint();
-
-        // capture stones
-        for (const auto& group : theirAffectedGroups){
-            if (utils::getLiberties(*group, *board).empty()){
+        if (move.getStone() == EMPTY){
+            // removing a stone cannot capture anything
+            return;
+        }
 
-                // check for a Ko
-                // if we captured a stone without affecting any of our groups
-                if (ourAffectedGroups.empty() and group->getMoves().size() == 1){
+        // find any enemy chains that this move took the last liberty of
+        unsigned capturedChains = 0;
+        unsigned lastCapture = index;
 
-                    bool ko = true;
+        groups.forEachAdjacentChain(index, getOpponent(move.getStone()), [&](unsigned root){
+            if (not groups.hasLiberties(root)){
+                capturedChains++;
+                lastCapture = root;
+            }
+        });
 
-                    Move KoMove = *group->getMoves().begin();
+        // check for a Ko
+        // a single stone capture by a stone with no friendly neighbors and no other liberties
+        if (capturedChains == 1 and groups.getStoneCount(lastCapture) == 1 and groups.getStoneCount(index) == 1
+            and not groups.hasLiberties(index)){
+            koPoint = Move(lastCapture / board->getSide(), lastCapture % board->getSide(), getOpponent(move.getStone()));
+        }
 
-                    // make sure that the capturing stone is captured before the stone is removed
-                    for (const auto& adjacentSpace : move.getAdjacentMoves(board->getSide())){
-                        ko = ko and board->getSpace(adjacentSpace).getStone()
-                                    == getOpponent(move.getStone());
+        // capture the stones
+        if (capturedChains > 0){
+            groups.forEachAdjacentChain(index, getOpponent(move.getStone()), [&](unsigned root){
+                if (not groups.hasLiberties(root)){
+                    captureChain(root);
+                }
+            });
+        }
 
-                    }
+        // Handle legal self-captures under Tromp-Taylor rules
+        if (rules == TROMP_TAYLOR and not groups.hasLiberties(index)) {
+            captureChain(index);
+        }
+    }
 
-                    // if this is a real ko, update the ko move
-                    if (ko){
-                        koPoint = KoMove;
-                    }
+    /**
+     *
+     * removes a chain of stones from the board and records it as captured
+     *
+     * @param index any stone in the chain
+     */
+    void GoGame::captureChain(unsigned index){
 
-                }
+        unsigned side = board->getSide();
 
-                // capture the stones
-                for (const auto& stone : group->getMoves()){
-                    // erase the item
-                    groups.erase(stone);
-                    board->captureStone(stone);
-                    capturedStones[gameTree.getDepth()].insert(stone);
-                }
-            }
+        unsigned depth = getMoveNumber();
+        if (capturedStones.size() <= depth){
+            capturedStones.resize(depth + 1);
         }
 
-        // Handle legal self-captures under Tromp-Taylor rules
-        if (rules == TROMP_TAYLOR and not isNotSelfCapture(move)) {
-            // erase the item
-            groups.erase(move);
-            board->captureStone(move);
-            capturedStones[gameTree.getDepth()].insert(move);
-        }
+        groups.forEachStone(index, [&](unsigned stone){
+            Move captured(stone / side, stone % side, groups.getStone(stone));
+            board->captureStone(captured);
+            zobristHash ^= utils::getZobristKey(captured);
+            (captured.getStone() == BLACK ? capturedStones[depth].black : capturedStones[depth].white).insert(stone);
+        });
+
+        groups.removeChain(index);
     }
 
     bool GoGame::isCorrectColor(const Move &move) {
@@ -1093,79 +1667,96 @@ namespace sente {
     }
 
     bool GoGame::isNotSelfCapture(const Move &move) const{
+        return not groups.isSelfCapture(groups.toIndex(move.getX(), move.getY()), move.getStone());
+    }
 
-        std::unordered_set<std::shared_ptr<Group>> ourAffectedGroups{};
-        std::unordered_set<std::shared_ptr<Group>> theirAffectedGroups{};
+    bool GoGame::isNotKoPoint(const Move &move) const{
+        return move != koPoint;
+    }
 
-        // check to see if this move extends a group
-        for (const auto& adjacentSpace : move.getAdjacentMoves(board->getSide())) {
-            Move temp = board->getSpace(adjacentSpace);
-            if (groups.find(temp) != groups.end()) {
-                if (groups.at(temp)->getColor() == move.getStone()) {
-                    ourAffectedGroups.insert(groups.at(temp));
-                }
-                else if (groups.at(temp)->getColor() == getOpponent(move.getStone())){
-                    theirAffectedGroups.insert(groups.at(temp));
-                }
-            }
-        }
+    /**
+     *
+     * checks a move against the superko rule by computing the hash of the position it would create and looking it
+     * up in the history of positions
+     *
+     * @param move move to check (must be on an empty point)
+     * @return whether the move avoids repeating a previous position (always true for simple ko)
+     */
+    bool GoGame::isNotSuperko(const Move &move) const {
 
-        // first of all check to see if we capture any stones
-        for (const auto& group : theirAffectedGroups){
-            if (utils::getLiberties(*group, *board).size() == 1){
-                // if an adjacent group is in atari, then playing on an empty space must capture
-                // any move that captures enemy stones is legal (ignoring kos)
-                return true;
-            }
+        if (koRule == SIMPLE_KO){
+            return true;
         }
 
-        // create a temporary group object and merge all the affected groups into it
-        Group affectedGroup;
+        unsigned side = board->getSide();
+        unsigned index = groups.toIndex(move.getX(), move.getY());
+        Stone opponent = getOpponent(move.getStone());
 
-        if (not ourAffectedGroups.empty()){
-            affectedGroup = Group(move, ourAffectedGroups);
-        }
-        else {
-            affectedGroup = Group(move);
-        }
+        uint64_t nextHash = zobristHash ^ utils::getZobristKey(move);
+        bool captures = false;
 
-        // temporarily put the stone on the board and count the liberties
-        auto liberties = utils::getLiberties(affectedGroup, *board);
+        groups.forEachCapturedChain(index, move.getStone(), [&](unsigned root){
+            captures = true;
+            groups.forEachStone(root, [&](unsigned stone){
+                nextHash ^= utils::getZobristKey(Move(stone / side, stone % side, opponent));
+            });
+        });
 
-        // check to see if this move fills the last liberty
-        bool filledLastLiberty = false;
-        if (liberties.size() == 1){
-            auto liberty = *liberties.begin();
-            filledLastLiberty = liberty.getX() == move.getX() and liberty.getY() == move.getY();
+        // under Tromp-Taylor rules a self-capture removes our own chain instead
+        if (not captures and rules == TROMP_TAYLOR and groups.isSelfCapture(index, move.getStone())){
+            nextHash ^= utils::getZobristKey(move);
+            groups.forEachAdjacentChain(index, move.getStone(), [&](unsigned root){
+                groups.forEachStone(root, [&](unsigned stone){
+                    nextHash ^= utils::getZobristKey(Move(stone / side, stone % side, move.getStone()));
+                });
+            });
         }
 
-        return not liberties.empty() and not filledLastLiberty;
-    }
-
-    bool GoGame::isNotKoPoint(const Move &move) const{
-        return move != koPoint;
+        return positionHistory.find(getPositionKey(nextHash, opponent)) == positionHistory.end();
     }
 
-    bool GoGame::isOver() const {
-        return gameTree.getRoot().hasProperty(SGF::RE);
+    /**
+     *
+     * combines the hash of the stones on the board with the player to move, according to the superko rule in use
+     *
+     * @param hash Zobrist hash of the board
+     * @param toPlay player to move
+     * @return key to store in the position history
+     */
+    uint64_t GoGame::getPositionKey(uint64_t hash, Stone toPlay) const {
+        if (koRule == SITUATIONAL_SUPERKO){
+            return hash ^ utils::getZobristKey(toPlay);
+        }
+        return hash;
     }
 
     /**
      *
-     * connect a vector of groups of stone using the specified move
+     * adds the current position to the position history
      *
-     * @param move
-     * @param groups
      */
-    void GoGame::connectGroups(const Move& move, const std::unordered_set<std::shared_ptr<Group>>& toConnect) {
+    void GoGame::recordPosition() {
+        positionHistory.insert(getPositionKey(zobristHash, activeColor));
+    }
 
-        // create the new group object
-        auto newGroup = std::make_shared<Group>(move, toConnect);
+    bool GoGame::isOver() const {
+        return playoutResignation != EMPTY or gameTree.getRoot().hasProperty(SGF::RE);
+    }
 
-        // set each move in the new Group to point to the new group
-        for (const auto& stone : newGroup->getMoves()){
-            groups[stone] = newGroup;
-        }
+    KoRule GoGame::getKoRule() const {
+        return koRule;
+    }
+
+    uint64_t GoGame::getHash() const {
+        return zobristHash;
+    }
+
+    /**
+     *
+     * @return the number of passes that have been played in a row at the current position
+     */
+    unsigned GoGame::getPassCount() const {
+        return passCount;
     }
 
     Rules GoGame::getRules() const {
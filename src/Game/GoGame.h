@@ -16,8 +16,10 @@
 #include <pybind11/pybind11.h>
 
 #include "../Utils/Tree.h"
-#include "Group.h"
+#include "GameState.h"
 #include "GoComponents.h"
+#include "GroupTable.h"
+#include "PointSet.h"
 #include "../Utils/SGF/SGFNode.h"
 
 #ifdef __CYGWIN__
@@ -39,13 +41,29 @@ namespace sente {
 
     typedef std::variant<Move, std::unordered_set<Move>> Playable;
 
+    /**
+     *
+     * the points covered by each player's stones
+     *
+     */
+    struct StoneSets {
+        PointSet black;
+        PointSet white;
+    };
+
+    // number of the last moves (and the positions before them) that a clone without history remembers, which is as far
+    // back as the history features look
+    constexpr unsigned CLONE_HISTORY = 7;
+
     class GoGame {
     public:
 
         GoGame(unsigned side, Rules rules, double komi,
-               std::unordered_set<Move> handicap);
+               std::unordered_set<Move> handicap, KoRule koRule = SIMPLE_KO);
         explicit GoGame(utils::Tree<SGF::SGFNode>& SGFTree);
 
+        [[nodiscard]] GoGame clone(bool keepHistory = true) const;
+
         void resetBoard();
 
         ///
@@ -56,12 +74,17 @@ namespace sente {
         bool isLegal(unsigned x, unsigned y);
         bool isLegal(unsigned x, unsigned y, Stone stone);
         bool isGTPLegal(const Move& move);
+        MoveStatus getMoveStatus(const Move& move);
         [[nodiscard]] bool isOver() const;
 
         void playStone(const Move& move);
         void playStone(unsigned x, unsigned y);
         void playStone(unsigned x, unsigned y, Stone stone);
 
+        MoveStatus tryPlay(const Move& move);
+        MoveStatus tryPlay(unsigned x, unsigned y);
+        MoveStatus tryPlay(unsigned x, unsigned y, Stone stone);
+
         bool isAddLegal(const Move& move);
 
         void addStones(const std::unordered_set<Move>& moves);
@@ -83,8 +106,19 @@ namespace sente {
         std::vector<std::vector<Playable>> getSequences(const std::vector<Playable>& currentSequence);
 
         [[nodiscard]] unsigned getMoveNumber() const;
+        [[nodiscard]] std::vector<Move> getRecentMoves(unsigned count) const;
+        [[nodiscard]] std::vector<StoneSets> getRecentPositions(unsigned count) const;
         [[nodiscard]] utils::Tree<SGF::SGFNode> getMoveTree() const;
 
+        ///
+        /// playouts
+        ///
+
+        void startPlayout();
+        void endPlayout();
+        void commitPlayout();
+        [[nodiscard]] bool isInPlayout() const;
+
         ///
         /// Getting and setting properties
         ///
@@ -111,13 +145,43 @@ namespace sente {
         [[nodiscard]] std::unique_ptr<_board> copyBoard() const;
         [[nodiscard]] unsigned getSide() const;
 
+        /**
+         *
+         * calls a generic function with a statically sized view of the current position. The size of the board is
+         * only resolved once per call, so the function can loop over the board without any virtual calls
+         *
+         * @param function function to call with a GameState<side>
+         * @return the result of the function
+         */
+        template<typename Function>
+        auto visitState(Function function) const {
+            return dispatchSide(board->getSide(), [&](auto size){
+                constexpr unsigned side = decltype(size)::value;
+                return function(GameState<side>(static_cast<const Board<side>&>(*board), groups));
+            });
+        }
+
         void score();
+        [[nodiscard]] PositionScore scorePosition() const;
+
+        void setDeadStones(const std::vector<Move>& stones);
+        void setDeadStonesFromTerritory();
+        [[nodiscard]] std::vector<Move> getDeadStones() const;
+        [[nodiscard]] std::vector<Move> findDeadStones() const;
+        [[nodiscard]] std::vector<Move> getPassAliveArea(Stone color) const;
         std::string getResult() const;
         sente::Stone getWinner() const;
         py::dict getScores() const;
         std::vector<Move> getLegalMoves();
+        [[nodiscard]] PointSet getLegalPoints() const;
+        [[nodiscard]] const std::vector<uint8_t>& getLegalMask();
 
         Vertex getKoPoint() const;
+        [[nodiscard]] std::vector<Move> getLiberties(unsigned x, unsigned y) const;
+        [[nodiscard]] unsigned countLiberties(unsigned x, unsigned y) const;
+        KoRule getKoRule() const;
+        uint64_t getHash() const;
+        [[nodiscard]] unsigned getPassCount() const;
 
         Rules getRules() const;
         double getKomi() const;
@@ -146,14 +210,80 @@ namespace sente {
         // Changes.txt: look into moving the board onto the stack
         std::shared_ptr<_board> board; // 16 bytes
 
+        // chains of stones on the board, kept in step with the board by updateBoard
+        GroupTable groups;
+
         utils::Tree<SGF::SGFNode> gameTree; // 32 bytes
 
-        std::unordered_map<Move, std::shared_ptr<Group>> groups; // 40 bytes
-        std::unordered_map<unsigned, std::unordered_set<Move>> capturedStones; // 40 bytes
+        /**
+         *
+         * the stones that were captured when the board reached a given depth of the game tree
+         *
+         */
+        struct CapturedStones {
+            PointSet black;
+            PointSet white;
+        };
 
-        // total size: 64 + 80 = 144 bytes
+        // indexed by depth, only the entries for the current line of play are filled in
+        std::vector<CapturedStones> capturedStones;
+
+        // stones of each color captured before the game was cloned without its history, which territory scoring
+        // still takes off as prisoners
+        unsigned earlierBlackCaptures = 0;
+        unsigned earlierWhiteCaptures = 0;
+
+        // total size: 64 + 40 = 104 bytes
 
         Move koPoint;
+        KoRule koRule = SIMPLE_KO;
+
+        // Zobrist hash of the stones on the board and the hashes of every position the game has passed through
+        uint64_t zobristHash = 0;
+        std::unordered_multiset<uint64_t> positionHistory;
+
+        /**
+         *
+         * the state that a move overwrote, which is enough to take the move back without replaying the game. The
+         * stones captured by the move are kept in capturedStones under the same depth
+         *
+         */
+        struct UndoRecord {
+            Move move;
+            unsigned depth;
+            Move koPoint;
+            unsigned passCount;
+            Stone activeColor;
+            uint64_t zobristHash;
+            uint64_t positionKey;
+            double blackPoints;
+            double whitePoints;
+            Stone resigned;
+        };
+
+        // one record for every move played since the board was last reset
+        std::vector<UndoRecord> undoJournal;
+
+        // the last moves and the positions before them from before the game was cloned without its history, most
+        // recent first, so that the clone still knows how its position came about
+        std::vector<Move> earlierMoves;
+        std::vector<StoneSets> earlierPositions;
+
+        // stones marked as dead for scoring, only valid for the position with the recorded hash
+        PointSet deadStones;
+        uint64_t deadStonesHash = 0;
+
+        // one byte for each point of the board followed by one for passing, overwritten by getLegalMask
+        std::vector<uint8_t> legalMask;
+
+        // moves played during a playout are only kept in the undo journal, not in the game tree
+        bool inPlayout = false;
+        unsigned playoutLength = 0;
+        // player that resigned during the playout (if any), which is journaled rather than written to the game tree
+        Stone playoutResignation = EMPTY;
+
+        // only used by clone, which fills in every member itself
+        GoGame() = default;
 
         void makeBoard(unsigned side);
         void clearBoard();
@@ -162,11 +292,20 @@ namespace sente {
         [[nodiscard]] Stone getStartingColor() const;
 
         void updateBoard(const Move& move);
-        void connectGroups(const Move& move, const std::unordered_set<std::shared_ptr<Group>>& toConnect);
+        void captureChain(unsigned index);
+        void journalMove(UndoRecord record);
+        void undoMove();
+        [[nodiscard]] bool journalReachesRoot() const;
 
         bool isCorrectColor(const Move& move);
         bool isNotSelfCapture(const Move& move) const;
         bool isNotKoPoint(const Move& move) const;
+        bool isNotSuperko(const Move& move) const;
+
+        [[nodiscard]] PointSet getMarkedDeadStones() const;
+
+        [[nodiscard]] uint64_t getPositionKey(uint64_t hash, Stone toPlay) const;
+        void recordPosition();
     };
 }
 
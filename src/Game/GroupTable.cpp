@@ -0,0 +1,321 @@
+#include <utility>
+
+#include "GroupTable.h"
+
+namespace sente {
+
+    GroupTable::GroupTable(unsigned side) : side(side),
+                                            stones(side * side),
+                                            parent(side * side),
+                                            nextStone(side * side),
+                                            stoneCount(side * side),
+                                            liberties(side * side) {
+        clear();
+    }
+
+    /**
+     *
+     * removes every stone from the table
+     *
+     */
+    void GroupTable::clear(){
+        for (unsigned index = 0; index < side * side; index++){
+            stones[index] = EMPTY;
+            parent[index] = index;
+            nextStone[index] = index;
+            stoneCount[index] = 0;
+            liberties[index].clear();
+        }
+
+        // every point of an empty board is legal
+        blackLegal.clear();
+        whiteLegal.clear();
+        for (unsigned index = 0; index < side * side; index++){
+            blackLegal.insert(index);
+            whiteLegal.insert(index);
+        }
+    }
+
+    /**
+     *
+     * recomputes the table from the stones on a board. Used when stones are removed from the board without being
+     * captured (which can split a chain in two)
+     *
+     * @param board board to copy the stones of
+     */
+    void GroupTable::rebuild(const _board& board){
+        clear();
+        for (unsigned x = 0; x < side; x++){
+            for (unsigned y = 0; y < side; y++){
+                Stone stone = board.getStone(x, y);
+                if (stone != EMPTY){
+                    placeStone(toIndex(x, y), stone);
+                }
+            }
+        }
+    }
+
+    unsigned GroupTable::getSide() const {
+        return side;
+    }
+
+    unsigned GroupTable::toIndex(unsigned x, unsigned y) const {
+        return x * side + y;
+    }
+
+    Stone GroupTable::getStone(unsigned index) const {
+        return stones[index];
+    }
+
+    /**
+     *
+     * finds the root of the chain containing a stone
+     *
+     * @param index stone to look up
+     * @return index of the root of the chain
+     */
+    unsigned GroupTable::find(unsigned index) const {
+        while (parent[index] != index){
+            index = parent[index];
+        }
+        return index;
+    }
+
+    /**
+     *
+     * finds the root of the chain containing a stone, shortening the path to the root on the way. Unlike find, this
+     * writes to the table, so it is only used while the table is being changed
+     *
+     * @param index stone to look up
+     * @return index of the root of the chain
+     */
+    unsigned GroupTable::compressPath(unsigned index){
+        while (parent[index] != index){
+            // path halving keeps the trees shallow without a second pass
+            parent[index] = parent[parent[index]];
+            index = parent[index];
+        }
+        return index;
+    }
+
+    unsigned GroupTable::getStoneCount(unsigned index) const {
+        return stoneCount[find(index)];
+    }
+
+    const PointSet& GroupTable::getLiberties(unsigned index) const {
+        return liberties[find(index)];
+    }
+
+    unsigned GroupTable::countLiberties(unsigned index) const {
+        return getLiberties(index).size();
+    }
+
+    bool GroupTable::hasLiberties(unsigned index) const {
+        return not getLiberties(index).empty();
+    }
+
+    /**
+     *
+     * determines whether an empty point is the only liberty of a chain
+     *
+     * @param root root of the chain
+     * @param index empty point next to the chain
+     * @return whether the chain has no liberties other than the point
+     */
+    bool GroupTable::isLastLiberty(unsigned root, unsigned index) const {
+        const PointSet& chainLiberties = liberties[root];
+        return chainLiberties.contains(index) and chainLiberties.size() == 1;
+    }
+
+    /**
+     *
+     * determines whether a move on an empty point captures any enemy stones
+     *
+     * @param index point to play on
+     * @param color color of the stone to play
+     * @return whether the move captures
+     */
+    bool GroupTable::isCapture(unsigned index, Stone color) const {
+        bool capture = false;
+        forEachCapturedChain(index, color, [&](unsigned){
+            capture = true;
+        });
+        return capture;
+    }
+
+    /**
+     *
+     * determines whether a move on an empty point would leave its own chain without liberties
+     *
+     * @param index point to play on
+     * @param color color of the stone to play
+     * @return whether the move is a self-capture
+     */
+    bool GroupTable::isSelfCapture(unsigned index, Stone color) const {
+
+        bool hasLiberty = false;
+
+        forEachNeighbor(index, [&](unsigned neighbor){
+            hasLiberty = hasLiberty or stones[neighbor] == EMPTY;
+        });
+
+        // connecting to a chain with another liberty shares that liberty
+        forEachAdjacentChain(index, color, [&](unsigned root){
+            hasLiberty = hasLiberty or not isLastLiberty(root, index);
+        });
+
+        // capturing frees up a liberty
+        return not hasLiberty and not isCapture(index, color);
+    }
+
+    /**
+     *
+     * gets the empty points that a color can play on without capturing its own stones. Ko is not taken into account
+     *
+     * @param color color of the stone to play
+     * @return set of points that the color can play on
+     */
+    const PointSet& GroupTable::getLegalPoints(Stone color) const {
+        return color == BLACK ? blackLegal : whiteLegal;
+    }
+
+    /**
+     *
+     * places a stone on an empty point and merges it with its neighbors. Captures are left to the caller
+     *
+     * @param index point to place the stone on
+     * @param color color of the stone
+     */
+    void GroupTable::placeStone(unsigned index, Stone color){
+
+        stones[index] = color;
+        parent[index] = index;
+        nextStone[index] = index;
+        stoneCount[index] = 1;
+        liberties[index].clear();
+
+        forEachNeighbor(index, [&](unsigned neighbor){
+            if (stones[neighbor] == EMPTY){
+                liberties[index].insert(neighbor);
+            }
+            else {
+                // the new stone takes up a liberty of this neighbor
+                liberties[compressPath(neighbor)].erase(index);
+            }
+        });
+
+        forEachNeighbor(index, [&](unsigned neighbor){
+            if (stones[neighbor] == color){
+                merge(compressPath(index), compressPath(neighbor));
+            }
+        });
+
+        blackLegal.erase(index);
+        whiteLegal.erase(index);
+
+        // the legality of a point only changes if one of its neighbors was filled or a chain next to it was left
+        // with that point as its last liberty
+        forEachNeighbor(index, [&](unsigned neighbor){
+            if (stones[neighbor] == EMPTY){
+                updateLegality(neighbor);
+                return;
+            }
+            const PointSet& chainLiberties = liberties[compressPath(neighbor)];
+            if (chainLiberties.size() == 1){
+                chainLiberties.forEach([&](Point liberty){
+                    updateLegality(liberty);
+                });
+            }
+        });
+    }
+
+    /**
+     *
+     * removes all the stones in a chain from the table, giving back liberties to the chains around it
+     *
+     * @param index any stone in the chain
+     */
+    void GroupTable::removeChain(unsigned index){
+
+        unsigned root = compressPath(index);
+
+        // empty all the points first so only the surviving chains get liberties back
+        forEachStone(root, [&](unsigned stone){
+            stones[stone] = EMPTY;
+        });
+
+        // points whose legality may change: the emptied points and the last liberty of any chain that gains liberties
+        PointSet changed;
+
+        forEachStone(root, [&](unsigned stone){
+            changed.insert(stone);
+            forEachNeighbor(stone, [&](unsigned neighbor){
+                if (stones[neighbor] != EMPTY){
+                    PointSet& chainLiberties = liberties[compressPath(neighbor)];
+                    if (chainLiberties.size() == 1){
+                        changed |= chainLiberties;
+                    }
+                    chainLiberties.insert(stone);
+                }
+            });
+        });
+
+        forEachStone(root, [&](unsigned stone){
+            parent[stone] = stone;
+            nextStone[stone] = stone;
+            stoneCount[stone] = 0;
+            liberties[stone].clear();
+        });
+
+        changed.forEach([&](Point point){
+            updateLegality(point);
+        });
+    }
+
+    /**
+     *
+     * joins two chains together (union by size)
+     *
+     * @param first root of the first chain
+     * @param second root of the second chain
+     */
+    void GroupTable::merge(unsigned first, unsigned second){
+
+        if (first == second){
+            return;
+        }
+
+        if (stoneCount[first] < stoneCount[second]){
+            std::swap(first, second);
+        }
+
+        parent[second] = first;
+        stoneCount[first] += stoneCount[second];
+        liberties[first] |= liberties[second];
+
+        // splice the two rings of stones together
+        std::swap(nextStone[first], nextStone[second]);
+    }
+
+    /**
+     *
+     * recomputes whether each color can play on a point
+     *
+     * @param index point to check
+     */
+    void GroupTable::updateLegality(unsigned index){
+        if (stones[index] == EMPTY and not isSelfCapture(index, BLACK)){
+            blackLegal.insert(index);
+        }
+        else {
+            blackLegal.erase(index);
+        }
+        if (stones[index] == EMPTY and not isSelfCapture(index, WHITE)){
+            whiteLegal.insert(index);
+        }
+        else {
+            whiteLegal.erase(index);
+        }
+    }
+
+}
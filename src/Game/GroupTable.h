@@ -0,0 +1,171 @@
+#ifndef SENTE_GROUPTABLE_H
+#define SENTE_GROUPTABLE_H
+
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <ciso646>
+
+#include "Board.h"
+#include "PointSet.h"
+
+namespace sente {
+
+    /**
+     *
+     * Point indexed table of the chains of stones on a board.
+     *
+     * Every point stores the parent of its stone in a union-find forest and the next stone of its chain in a circular
+     * linked list. The root of each chain stores the number of stones in the chain and the set of its liberties, which
+     * is kept up to date as stones are placed, chains merge and chains are captured, so liberties never have to be
+     * searched for. The points where each color can play without self-capture are kept up to date in the same way.
+     *
+     * All storage is allocated once when the table is created, so placing stones and merging chains never allocates.
+     *
+     */
+    class GroupTable {
+    public:
+
+        GroupTable() = default;
+        explicit GroupTable(unsigned side);
+
+        void clear();
+        void rebuild(const _board& board);
+
+        [[nodiscard]] unsigned getSide() const;
+        [[nodiscard]] unsigned toIndex(unsigned x, unsigned y) const;
+
+        [[nodiscard]] Stone getStone(unsigned index) const;
+        [[nodiscard]] unsigned find(unsigned index) const;
+
+        [[nodiscard]] unsigned getStoneCount(unsigned index) const;
+        [[nodiscard]] const PointSet& getLiberties(unsigned index) const;
+        [[nodiscard]] unsigned countLiberties(unsigned index) const;
+        [[nodiscard]] bool hasLiberties(unsigned index) const;
+
+        [[nodiscard]] bool isLastLiberty(unsigned root, unsigned index) const;
+        [[nodiscard]] bool isCapture(unsigned index, Stone color) const;
+        [[nodiscard]] bool isSelfCapture(unsigned index, Stone color) const;
+
+        [[nodiscard]] const PointSet& getLegalPoints(Stone color) const;
+
+        void placeStone(unsigned index, Stone color);
+        void removeChain(unsigned index);
+
+        /**
+         *
+         * calls a function on the index of each point orthogonally adjacent to a point
+         *
+         * @param index point to get the neighbors of
+         * @param function function to call on each neighbor
+         */
+        template<typename Function>
+        void forEachNeighbor(unsigned index, Function function) const {
+            unsigned x = index / side;
+            unsigned y = index % side;
+
+            if (x + 1 < side){
+                function(index + side);
+            }
+            if (x > 0){
+                function(index - side);
+            }
+            if (y + 1 < side){
+                function(index + 1);
+            }
+            if (y > 0){
+                function(index - 1);
+            }
+        }
+
+        /**
+         *
+         * calls a function on the root of each distinct chain of a given color adjacent to a point
+         *
+         * @param index point to look around
+         * @param color color of the chains to look for
+         * @param function function to call on each root
+         */
+        template<typename Function>
+        void forEachAdjacentChain(unsigned index, Stone color, Function function) const {
+
+            std::array<unsigned, 4> seen{};
+            unsigned count = 0;
+
+            forEachNeighbor(index, [&](unsigned neighbor){
+                if (stones[neighbor] != color){
+                    return;
+                }
+                unsigned root = find(neighbor);
+                for (unsigned i = 0; i < count; i++){
+                    if (seen[i] == root){
+                        return;
+                    }
+                }
+                seen[count++] = root;
+                function(root);
+            });
+        }
+
+        /**
+         *
+         * calls a function on the index of every stone in the chain containing a point
+         *
+         * @param index point in the chain
+         * @param function function to call on each stone
+         */
+        template<typename Function>
+        void forEachStone(unsigned index, Function function) const {
+            unsigned stone = index;
+            do {
+                // the function may remove the stone, so step past it first
+                unsigned next = nextStone[stone];
+                function(stone);
+                stone = next;
+            } while (stone != index);
+        }
+
+        /**
+         *
+         * calls a function on the root of every enemy chain that a move on an empty point would capture
+         *
+         * @param index point to play on
+         * @param color color of the stone to play
+         * @param function function to call on each captured chain
+         */
+        template<typename Function>
+        void forEachCapturedChain(unsigned index, Stone color, Function function) const {
+            forEachAdjacentChain(index, getOpponent(color), [&](unsigned root){
+                if (isLastLiberty(root, index)){
+                    function(root);
+                }
+            });
+        }
+
+    private:
+
+        unsigned side = 0;
+
+        std::vector<Stone> stones;
+
+        // the union-find forest, which is only compressed when the table changes so that reading it is thread safe
+        std::vector<uint16_t> parent;
+        std::vector<uint16_t> nextStone;
+
+        // only valid at the root of a chain
+        std::vector<uint16_t> stoneCount;
+        std::vector<PointSet> liberties;
+
+        // empty points that each color can play on without self-capture (ko is left to the game)
+        PointSet blackLegal;
+        PointSet whiteLegal;
+
+        unsigned compressPath(unsigned index);
+        void merge(unsigned first, unsigned second);
+        void updateLegality(unsigned index);
+
+    };
+
+}
+
+#endif //SENTE_GROUPTABLE_H
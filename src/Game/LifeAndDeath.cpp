@@ -8,110 +8,67 @@ namespace sente::utils {
 
     /**
      *
-     * get a set containing all of the moves
+     * calls a function on the statically sized version of a board
      *
-     * @param group
-     * @param board
-     * @return
+     * @param board board to dispatch on
+     * @param function generic function to call with a Board<side>
+     * @return the result of the function
      */
-    std::unordered_set<Move> getLiberties(const Group& group, const _board& board) {
-
-        std::unordered_set<Move> liberties;
-
-        for (const auto& move : group.getMoves()){
-
-            for (const auto& adjacentSpace : move.getAdjacentMoves(board.getSide())){
-                if (board.getSpace(adjacentSpace.getX(), adjacentSpace.getY()).getStone() == EMPTY){
-                    liberties.insert(Move(adjacentSpace.getX(), adjacentSpace.getY(), EMPTY));
-                }
-            }
-        }
-
-        return liberties;
-
+    template<typename Function>
+    auto dispatch(const _board& board, Function function){
+        return dispatchSide(board.getSide(), [&](auto size){
+            return function(static_cast<const Board<decltype(size)::value>&>(board));
+        });
     }
 
     /**
      *
-     * generates a list of all groups that are adjacent to a territory
+     * counts the liberties of the chain containing a stone
      *
-     * @param territory territory to look for adjacent groups in
+     * @param stone stone in the chain
      * @param board board to look on
-     * @param groups map from moves to the group they belong to
-     * @return
+     * @return number of liberties
      */
-    std::unordered_set<std::shared_ptr<Group>> getAdjacentGroups(const std::unordered_set<Move>& territory,
-                                                const _board& board,
-                                                const std::unordered_map<Move, std::shared_ptr<Group>>& groupMap){
-
-        std::unordered_set<std::shared_ptr<Group>> groups;
-
-        for (const Move& move : territory){
-            for (const Vertex neighbor : move.getAdjacentMoves(board.getSide())){
-                if (groupMap.find(board.getSpace(neighbor)) != groupMap.end()){
-                    groups.insert(groupMap.at(board.getSpace(neighbor)));
-                }
-            }
-        }
-
-        return groups;
-
+    unsigned countLiberties(const Move& stone, const _board& board){
+        return dispatch(board, [&](const auto& sized){
+            return getLiberties(getConnectedPoints(stone, sized), sized).count();
+        });
     }
 
-
-
-    std::unordered_set<Move> getConnectedPoints(const Move& startMove,
-                                                const _board& board) {
-        auto connections = std::unordered_set<Move>{};
-        getConnectedPoints(startMove, board, connections);
-        return connections;
+    PointSet getConnectedPoints(const Move& startMove, const _board& board){
+        return dispatch(board, [&](const auto& sized){
+            return PointSet(getConnectedPoints(startMove, sized));
+        });
     }
 
-    /**
-     *
-     * finds all of the stones of the same color that are connected to a given starting move
-     *
-     * @param startMove
-     * @param foundConnections
-     * @return
-     */
-    void getConnectedPoints(const Move& startMove,
-                            const _board& board,
-                            std::unordered_set<Move>& foundConnections) {
-
-        // insert the current move into the list of found moves
-        foundConnections.insert(startMove);
-
-        for (const auto& point : startMove.getAdjacentMoves(board.getSide())){
-            Move move = board.getSpace(point);
-            // if we haven't seen the move before and the color of the stone is correct
-            if (foundConnections.find(move) == foundConnections.end() and move.getStone() == startMove.getStone()){
-                // insert this stone and all of it's children into the set
-                getConnectedPoints(move, board, foundConnections);
-            }
-        }
+    PointSet getLiberties(const Move& stone, const _board& board){
+        return dispatch(board, [&](const auto& sized){
+            return PointSet(getLiberties(getConnectedPoints(stone, sized), sized));
+        });
     }
 
-    std::vector<std::unordered_set<Move>> getEmptySpaces(const _board& board){
-
-        std::vector<std::unordered_set<Move>> regions;
-        std::unordered_set<Move> foundEmptyPoints;
+    PointSet getCapturedStones(const Move& move, const _board& board){
+        return dispatch(board, [&](const auto& sized){
+            return PointSet(getCapturedStones(move, sized));
+        });
+    }
 
-        for (unsigned i = 0; i < board.getSide(); i++){
-            for (unsigned j = 0; j < board.getSide(); j++){
-                if (board.getStone(i, j) == EMPTY){
-                    if (foundEmptyPoints.find(board.getSpace(i, j)) == foundEmptyPoints.end()){
-                        // add the region to the results
-                        regions.push_back(getConnectedPoints(board.getSpace(i, j), board));
-                        // skip any future moves in this region
-                        foundEmptyPoints.insert(regions.back().begin(), regions.back().end());
-                    }
-                }
-            }
-        }
+    bool isSelfCapture(const Move& move, const _board& board){
+        return dispatch(board, [&](const auto& sized){
+            return isSelfCapture(move, sized);
+        });
+    }
 
-        return regions;
+    PointSet getPassAliveArea(const _board& board, Stone color){
+        return dispatch(board, [&](const auto& sized){
+            return PointSet(getPassAliveArea(sized, color));
+        });
+    }
 
+    std::vector<EmptyRegion> getEmptySpaces(const _board& board){
+        return dispatch(board, [&](const auto& sized){
+            return getEmptySpaces(sized);
+        });
     }
 
 }
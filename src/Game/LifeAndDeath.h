@@ -5,29 +5,266 @@
 #ifndef SENTE_LIFEANDDEATH_H
 #define SENTE_LIFEANDDEATH_H
 
-#include <unordered_set>
+#include <vector>
 #include <ciso646>
 
 #include "Move.h"
 #include "Board.h"
-#include "Group.h"
+#include "Bitboard.h"
+#include "PointSet.h"
 
 
 namespace sente::utils {
 
-    std::unordered_set<Move> getLiberties(const Group& group, const _board& board);
+    /**
+     *
+     * summary of a connected region of empty points
+     *
+     */
+    struct EmptyRegion {
+        unsigned size;
+        bool bordersBlack;
+        bool bordersWhite;
+    };
 
-    std::unordered_set<std::shared_ptr<Group>> getAdjacentGroups(const std::unordered_set<Move>& territory,
-                                                            const _board& board,
-                                                            const std::unordered_map<Move, std::shared_ptr<Group>>& groups);
+    /**
+     *
+     * finds all of the points of the same color as a move that are connected to it (the move does not need to be
+     * on the board yet)
+     *
+     * @param startMove point to start from
+     * @param board board to look on
+     * @return set of connected points
+     */
+    template<unsigned side>
+    Bitboard<side> getConnectedPoints(const Move& startMove, const Board<side>& board){
+        auto start = Bitboard<side>::fromIndex(Bitboard<side>::toIndex(startMove.getX(), startMove.getY()));
+        return start.floodFill(board.getStones(startMove.getStone()) | start);
+    }
 
-    std::unordered_set<Move> getConnectedPoints(const Move& startMove,
-                                                const _board& board);
-    void getConnectedPoints(const Move& startMove,
-                            const _board& board,
-                            std::unordered_set<Move>& foundConnections);
+    /**
+     *
+     * get the set of liberties of a chain of stones
+     *
+     * @param chain stones to get the liberties of
+     * @param board board to look on
+     * @return the empty points adjacent to the chain
+     */
+    template<unsigned side>
+    Bitboard<side> getLiberties(const Bitboard<side>& chain, const Board<side>& board){
+        return chain.neighbors() & board.getEmptyPoints();
+    }
 
-    std::vector<std::unordered_set<Move>> getEmptySpaces(const _board& board);
+    /**
+     *
+     * finds the enemy stones that a move captures. The move may or may not have been placed on the board yet.
+     *
+     * @param move move to check
+     * @param board board to look on
+     * @return the stones of all the adjacent enemy chains whose last liberty is the move
+     */
+    template<unsigned side>
+    Bitboard<side> getCapturedStones(const Move& move, const Board<side>& board){
+
+        auto stone = Bitboard<side>::fromIndex(Bitboard<side>::toIndex(move.getX(), move.getY()));
+        auto empty = board.getEmptyPoints().without(stone);
+        auto theirs = board.getStones(getOpponent(move.getStone()));
+
+        Bitboard<side> captured;
+        Bitboard<side> adjacent = stone.neighbors() & theirs;
+
+        while (adjacent.any()){
+            auto chain = Bitboard<side>::fromIndex(adjacent.first()).floodFill(theirs);
+            if ((chain.neighbors() & empty).none()){
+                captured |= chain;
+            }
+            // skip the rest of the stones in this chain
+            adjacent = adjacent.without(chain);
+        }
+
+        return captured;
+    }
+
+    /**
+     *
+     * determines whether a move on an empty point would leave its own chain without liberties
+     *
+     * @param move move to check
+     * @param board board to look on
+     * @return whether the move is a self-capture
+     */
+    template<unsigned side>
+    bool isSelfCapture(const Move& move, const Board<side>& board){
+
+        auto stone = Bitboard<side>::fromIndex(Bitboard<side>::toIndex(move.getX(), move.getY()));
+        auto empty = board.getEmptyPoints().without(stone);
+
+        // any move that captures enemy stones gains a liberty
+        if (getCapturedStones(move, board).any()){
+            return false;
+        }
+
+        return (getConnectedPoints(move, board).neighbors() & empty).none();
+    }
+
+    /**
+     *
+     * labels every connected region of empty points on the board along with the colors that border it
+     *
+     * @param board board to look on
+     * @return list of empty regions
+     */
+    template<unsigned side>
+    std::vector<EmptyRegion> getEmptySpaces(const Board<side>& board){
+
+        std::vector<EmptyRegion> regions;
+
+        auto empty = board.getEmptyPoints();
+        auto black = board.getStones(BLACK);
+        auto white = board.getStones(WHITE);
+
+        while (empty.any()){
+            auto region = Bitboard<side>::fromIndex(empty.first()).floodFill(empty);
+            auto border = region.neighbors();
+
+            regions.push_back({region.count(), (border & black).any(), (border & white).any()});
+
+            // skip any future points in this region
+            empty = empty.without(region);
+        }
+
+        return regions;
+    }
+
+    /**
+     *
+     * splits a set of points into its connected components
+     *
+     * @param points points to split
+     * @return list of components
+     */
+    template<unsigned side>
+    std::vector<Bitboard<side>> getComponents(Bitboard<side> points){
+
+        std::vector<Bitboard<side>> components;
+
+        while (points.any()){
+            components.push_back(Bitboard<side>::fromIndex(points.first()).floodFill(points));
+            points = points.without(components.back());
+        }
+
+        return components;
+    }
+
+    /**
+     *
+     * finds the area that a color owns unconditionally with Benson's algorithm. A chain is pass-alive if it can
+     * never be captured even if its owner passes every turn, which is the case when it has two "vital" regions: regions
+     * enclosed by the color in which every empty point is a liberty of the chain. Chains are taken away until each
+     * remaining chain has two vital regions that only border remaining chains
+     *
+     * @param board board to look on
+     * @param color color to find the area of
+     * @return the pass-alive stones of the color and the regions they enclose that the opponent can never live in
+     * (including any enemy stones in them)
+     */
+    template<unsigned side>
+    Bitboard<side> getPassAliveArea(const Board<side>& board, Stone color){
+
+        auto ours = board.getStones(color);
+        auto empty = board.getEmptyPoints();
+
+        auto chains = getComponents(ours);
+        auto regions = getComponents(Bitboard<side>::full().without(ours));
+
+        // the chains that border each region and the regions that are vital to each chain
+        std::vector<std::vector<unsigned>> borderingChains(regions.size());
+        std::vector<std::vector<unsigned>> vitalRegions(chains.size());
+
+        for (unsigned region = 0; region < regions.size(); region++){
+            auto border = regions[region].neighbors();
+            auto regionEmpty = regions[region] & empty;
+            for (unsigned chain = 0; chain < chains.size(); chain++){
+                if ((border & chains[chain]).none()){
+                    continue;
+                }
+                borderingChains[region].push_back(chain);
+                if (regionEmpty.without(chains[chain].neighbors()).none()){
+                    vitalRegions[chain].push_back(region);
+                }
+            }
+        }
+
+        std::vector<bool> aliveChain(chains.size(), true);
+        std::vector<bool> healthyRegion(regions.size(), true);
+
+        bool changed = true;
+
+        while (changed){
+            changed = false;
+
+            // a chain needs at least two healthy vital regions
+            for (unsigned chain = 0; chain < chains.size(); chain++){
+                if (not aliveChain[chain]){
+                    continue;
+                }
+                unsigned eyes = 0;
+                for (unsigned region : vitalRegions[chain]){
+                    eyes += healthyRegion[region];
+                }
+                if (eyes < 2){
+                    aliveChain[chain] = false;
+                    changed = true;
+                }
+            }
+
+            // a region next to a chain that is not alive cannot be relied on
+            for (unsigned region = 0; region < regions.size(); region++){
+                if (not healthyRegion[region]){
+                    continue;
+                }
+                for (unsigned chain : borderingChains[region]){
+                    if (not aliveChain[chain]){
+                        healthyRegion[region] = false;
+                        changed = true;
+                        break;
+                    }
+                }
+            }
+        }
+
+        Bitboard<side> alive;
+        for (unsigned chain = 0; chain < chains.size(); chain++){
+            if (aliveChain[chain]){
+                alive |= chains[chain];
+            }
+        }
+
+        // the opponent cannot make an eye in a region where every empty point is next to a pass-alive chain
+        Bitboard<side> area = alive;
+        auto reach = alive.neighbors();
+
+        for (unsigned region = 0; region < regions.size(); region++){
+            if (healthyRegion[region] and not borderingChains[region].empty() and
+                (regions[region] & empty).without(reach).none()){
+                area |= regions[region];
+            }
+        }
+
+        return area;
+    }
+
+    unsigned countLiberties(const Move& stone, const _board& board);
+
+    PointSet getConnectedPoints(const Move& startMove, const _board& board);
+    PointSet getLiberties(const Move& stone, const _board& board);
+    PointSet getCapturedStones(const Move& move, const _board& board);
+
+    bool isSelfCapture(const Move& move, const _board& board);
+
+    PointSet getPassAliveArea(const _board& board, Stone color);
+
+    std::vector<EmptyRegion> getEmptySpaces(const _board& board);
 
 }
 
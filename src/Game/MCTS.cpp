@@ -0,0 +1,509 @@
+#include <cmath>
+#include <thread>
+#include <algorithm>
+#include <exception>
+
+#include "MCTS.h"
+#include "Playout.h"
+
+namespace sente {
+
+    PlayoutEvaluator::PlayoutEvaluator(uint64_t seed, unsigned maxMoves) : seed(seed), maxMoves(maxMoves) {}
+
+    /**
+     *
+     * plays a random game from each position and reports who won it
+     *
+     * @param games games in a playout at the positions to evaluate
+     * @return the result of each random game for the player to move, with uniform priors
+     */
+    std::vector<Evaluation> PlayoutEvaluator::evaluate(const std::vector<GoGame*>& games){
+
+        std::vector<Evaluation> evaluations(games.size());
+
+        for (unsigned i = 0; i < games.size(); i++){
+
+            GoGame& game = *games[i];
+            Stone player = game.getActivePlayer();
+
+            PlayoutRandom random(seed + evaluated++);
+            playRandomMoves(game, random, maxMoves == 0 ? 3 * game.getSide() * game.getSide() : maxMoves);
+
+            evaluations[i].value = getResultValue(game, player);
+        }
+
+        return evaluations;
+    }
+
+    /**
+     *
+     * @param options settings for the searches
+     * @param evaluator evaluator for the leaves of the search, random playouts are used if none is given
+     */
+    MCTS::MCTS(const SearchOptions& options, std::shared_ptr<Evaluator> evaluator)
+        : options(options), evaluator(std::move(evaluator)){
+        if (not this->evaluator){
+            this->evaluator = std::make_shared<PlayoutEvaluator>(options.seed);
+        }
+    }
+
+    /**
+     *
+     * searches a position and picks the move that was visited the most. The search is split between threads that
+     * each play the moves of the tree on their own copies of the game
+     *
+     * @param game game to search (it is not changed)
+     * @return the best move for the active player
+     */
+    Move MCTS::search(const GoGame& game){
+
+        std::lock_guard<std::mutex> searching(searchLock);
+
+        if (game.isOver() or game.getPassCount() >= 2){
+            return Move::pass(game.getActivePlayer());
+        }
+
+        {
+            std::lock_guard<std::mutex> guard(treeLock);
+            moveRoot(game);
+        }
+
+        unsigned threads = options.threads;
+        if (threads == 0){
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        threads = std::max(1u, std::min(threads, options.playouts));
+
+        unsigned batchSize = std::max(1u, options.batchSize);
+
+        // each thread gets one copy of the game for every leaf in its batches
+        std::vector<std::vector<GoGame>> games(threads);
+        for (auto& batch : games){
+            batch.reserve(batchSize);
+            for (unsigned i = 0; i < batchSize; i++){
+                batch.push_back(game.clone(false));
+            }
+        }
+
+        unsigned started = 0;
+        bool stop = false;
+
+        std::vector<std::exception_ptr> errors(threads);
+        std::vector<std::thread> workers;
+
+        for (unsigned thread = 0; thread < threads; thread++){
+            workers.emplace_back([&, thread](){
+                try {
+                    runThread(games[thread], started, stop);
+                }
+                catch (...){
+                    errors[thread] = std::current_exception();
+                    std::lock_guard<std::mutex> guard(treeLock);
+                    stop = true;
+                }
+            });
+        }
+
+        for (auto& worker : workers){
+            worker.join();
+        }
+
+        for (const auto& error : errors){
+            if (error){
+                // the paths of the unfinished leaves still carry their virtual losses
+                clear();
+                std::rethrow_exception(error);
+            }
+        }
+
+        const Node* best = nullptr;
+
+        for (const auto& child : root->children){
+            if (child.pruned){
+                continue;
+            }
+            if (best == nullptr or child.visits > best->visits or
+                (child.visits == best->visits and child.valueSum > best->valueSum)){
+                best = &child;
+            }
+        }
+
+        if (best == nullptr){
+            return Move::pass(game.getActivePlayer());
+        }
+
+        return best->move;
+    }
+
+    /**
+     *
+     * @return the search statistics of every move from the root of the tree
+     */
+    std::vector<MoveStatistics> MCTS::getStatistics() const {
+
+        std::lock_guard<std::mutex> guard(treeLock);
+
+        std::vector<MoveStatistics> statistics;
+
+        if (root){
+            for (const auto& child : root->children){
+                if (child.pruned){
+                    continue;
+                }
+                statistics.push_back({child.move, child.visits,
+                                      child.visits == 0 ? 0 : child.valueSum / child.visits, child.prior});
+            }
+        }
+
+        return statistics;
+    }
+
+    /**
+     *
+     * @return the number of evaluations below the root of the tree, including those from earlier searches
+     */
+    unsigned MCTS::getRootVisits() const {
+        std::lock_guard<std::mutex> guard(treeLock);
+        return root ? root->visits : 0;
+    }
+
+    /**
+     *
+     * @return the average result of the search for the player to move at the root, from -1 to 1
+     */
+    double MCTS::getRootValue() const {
+
+        std::lock_guard<std::mutex> guard(treeLock);
+
+        if (not root or root->visits == 0){
+            return 0;
+        }
+
+        // the root's values are for the player who moved into it
+        return -root->valueSum / root->visits;
+    }
+
+    /**
+     *
+     * throws away the tree
+     *
+     */
+    void MCTS::clear(){
+        std::lock_guard<std::mutex> guard(treeLock);
+        root.reset();
+    }
+
+    const SearchOptions& MCTS::getOptions() const {
+        return options;
+    }
+
+    /**
+     *
+     * moves the root of the tree to the position of a game. The root is kept if it is the same position, and one of
+     * its children or grandchildren becomes the new root if the game has moved on to it. Otherwise (or if the board
+     * size, komi or rules have changed), the tree is thrown away
+     *
+     * @param game game to move the root to
+     */
+    void MCTS::moveRoot(const GoGame& game){
+
+        if (root and game.getSide() == rootSide and game.getKomi() == rootKomi and game.getRules() == rootRules){
+
+            if (matches(*root, game)){
+                return;
+            }
+
+            for (auto& child : root->children){
+                if (matches(child, game)){
+                    auto next = std::make_unique<Node>(std::move(child));
+                    root = std::move(next);
+                    return;
+                }
+                for (auto& grandchild : child.children){
+                    if (matches(grandchild, game)){
+                        auto next = std::make_unique<Node>(std::move(grandchild));
+                        root = std::move(next);
+                        return;
+                    }
+                }
+            }
+        }
+
+        root = std::make_unique<Node>();
+        root->reached = true;
+        root->hash = game.getHash();
+        root->toPlay = game.getActivePlayer();
+        root->koPoint = game.getKoPoint();
+        root->passes = game.getPassCount();
+
+        rootSide = game.getSide();
+        rootKomi = game.getKomi();
+        rootRules = game.getRules();
+    }
+
+    /**
+     *
+     * @param node node of the tree
+     * @param game game to compare with
+     * @return whether the node is at the same position as the game
+     */
+    bool MCTS::matches(const Node& node, const GoGame& game){
+        return node.reached and node.hash == game.getHash() and node.toPlay == game.getActivePlayer()
+               and node.koPoint.getX() == game.getKoPoint().getX() and node.koPoint.getY() == game.getKoPoint().getY()
+               and node.passes == game.getPassCount();
+    }
+
+    /**
+     *
+     * picks the child of a node to search next. Threads that are evaluating a leaf below a child count as losses for
+     * it, which keeps the other threads from all searching the same line. Pruned children are skipped, passing is
+     * always legal so there is at least one child left
+     *
+     * @param node expanded node to pick the child of
+     * @return the child with the highest score
+     */
+    MCTS::Node* MCTS::selectChild(Node& node) const {
+
+        double parentVisits = node.visits + options.virtualLoss * node.inFlight;
+
+        Node* best = nullptr;
+        double bestScore = -INFINITY;
+
+        for (auto& child : node.children){
+
+            if (child.pruned){
+                continue;
+            }
+
+            double visits = child.visits + options.virtualLoss * child.inFlight;
+            double value = visits == 0 ? 0 : (child.valueSum - options.virtualLoss * child.inFlight) / visits;
+            double score;
+
+            if (options.selection == UCT){
+                if (visits == 0){
+                    // try every move once before exploiting any of them
+                    return &child;
+                }
+                score = value + options.exploration * std::sqrt(std::log(parentVisits) / visits);
+            }
+            else {
+                score = value + options.exploration * child.prior * std::sqrt(std::max(parentVisits, 1.0)) /
+                                (1 + visits);
+            }
+
+            if (score > bestScore){
+                best = &child;
+                bestScore = score;
+            }
+        }
+
+        return best;
+    }
+
+    /**
+     *
+     * walks down the tree to a node that has not been expanded yet and adds a virtual loss to the path
+     *
+     * @param leaf leaf to record the path in
+     */
+    void MCTS::selectLeaf(Leaf& leaf){
+
+        Node* node = root.get();
+        leaf.path = {node};
+
+        // finished games are never expanded, so the walk stops at them
+        while (node->expanded){
+            node = selectChild(*node);
+            leaf.path.push_back(node);
+        }
+
+        for (Node* step : leaf.path){
+            step->inFlight++;
+        }
+    }
+
+    /**
+     *
+     * adds a child to a node for every legal move and for passing
+     *
+     * @param node node to expand
+     * @param leaf evaluated leaf at the node
+     */
+    void MCTS::expand(Node& node, const Leaf& leaf){
+
+        unsigned side = leaf.game->getSide();
+        const auto& policy = leaf.evaluation.policy;
+        bool uniform = policy.empty();
+
+        node.children.reserve(leaf.legal.size() + 1);
+
+        leaf.legal.forEach([&](Point point){
+            Node child;
+            child.move = Move(point / side, point % side, leaf.toPlay);
+            child.prior = uniform ? 1 : policy[point];
+            node.children.push_back(std::move(child));
+        });
+
+        Node pass;
+        pass.move = Move::pass(leaf.toPlay);
+        pass.prior = uniform ? 1 : policy[side * side];
+        pass.passes = node.passes + 1;
+        node.children.push_back(std::move(pass));
+
+        // the policy may put weight on illegal moves, so the priors of the legal ones are scaled back up
+        double total = 0;
+        for (const auto& child : node.children){
+            total += child.prior;
+        }
+        for (auto& child : node.children){
+            child.prior = total > 0 ? float(child.prior / total) : 1.0f / float(node.children.size());
+        }
+
+        node.expanded = true;
+    }
+
+    /**
+     *
+     * adds the evaluation of a leaf to every node on its path and takes back the virtual loss
+     *
+     * @param leaf evaluated leaf
+     */
+    void MCTS::backup(Leaf& leaf){
+
+        // the leaf's value is for the player to move, and each node stores values for the player that moved into it
+        double value = -leaf.evaluation.value;
+
+        for (auto node = leaf.path.rbegin(); node != leaf.path.rend(); node++){
+            (*node)->inFlight--;
+            (*node)->visits++;
+            (*node)->valueSum += value;
+            value = -value;
+        }
+    }
+
+    /**
+     *
+     * searches on one thread until the search has started enough evaluations
+     *
+     * @param games copies of the game for the thread, one for each leaf in a batch
+     * @param started number of evaluations started by all of the threads
+     * @param stop set when another thread failed
+     */
+    void MCTS::runThread(std::vector<GoGame>& games, unsigned& started, bool& stop){
+
+        std::vector<Leaf> leaves(games.size());
+
+        unsigned side = games.front().getSide();
+
+        while (true){
+
+            unsigned count = 0;
+
+            {
+                std::lock_guard<std::mutex> guard(treeLock);
+                for (; count < games.size() and started < options.playouts and not stop; count++, started++){
+                    leaves[count].game = &games[count];
+                    selectLeaf(leaves[count]);
+                }
+            }
+
+            if (count == 0){
+                return;
+            }
+
+            std::vector<GoGame*> toEvaluate;
+            std::vector<Leaf*> pending;
+
+            for (unsigned i = 0; i < count; i++){
+
+                Leaf& leaf = leaves[i];
+                GoGame& game = *leaf.game;
+
+                game.startPlayout();
+                leaf.illegal = nullptr;
+                for (auto node = leaf.path.begin() + 1; node != leaf.path.end(); node++){
+                    // a subtree kept from an earlier search may have moves that the ko or superko rule forbids here
+                    if (game.tryPlay((*node)->move) != LEGAL){
+                        leaf.illegal = *node;
+                        break;
+                    }
+                }
+
+                if (leaf.illegal){
+                    continue;
+                }
+
+                leaf.hash = game.getHash();
+                leaf.toPlay = game.getActivePlayer();
+                leaf.koPoint = game.getKoPoint();
+                leaf.evaluation = Evaluation();
+
+                if (leaf.path.back()->passes >= 2){
+                    // the game is over, so the result is known exactly
+                    leaf.evaluation.value = getResultValue(game, leaf.toPlay);
+                }
+                else {
+                    leaf.legal = game.getLegalPoints();
+                    toEvaluate.push_back(&game);
+                    pending.push_back(&leaf);
+                }
+            }
+
+            if (not toEvaluate.empty()){
+
+                auto evaluations = evaluator->evaluate(toEvaluate);
+
+                if (evaluations.size() != toEvaluate.size()){
+                    throw std::domain_error("evaluator returned " + std::to_string(evaluations.size()) +
+                                            " evaluations for " + std::to_string(toEvaluate.size()) + " positions");
+                }
+
+                for (unsigned i = 0; i < pending.size(); i++){
+                    if (not evaluations[i].policy.empty() and evaluations[i].policy.size() != side * side + 1){
+                        throw std::domain_error("evaluator returned a policy with " +
+                                                std::to_string(evaluations[i].policy.size()) + " entries, expected " +
+                                                std::to_string(side * side + 1));
+                    }
+                    pending[i]->evaluation = std::move(evaluations[i]);
+                }
+            }
+
+            {
+                std::lock_guard<std::mutex> guard(treeLock);
+                for (unsigned i = 0; i < count; i++){
+
+                    if (leaves[i].illegal){
+                        // the leaf is thrown away without an evaluation and does not count towards the playouts
+                        leaves[i].illegal->pruned = true;
+                        for (Node* step : leaves[i].path){
+                            step->inFlight--;
+                        }
+                        started--;
+                        continue;
+                    }
+
+                    Node& node = *leaves[i].path.back();
+
+                    if (not node.reached){
+                        node.reached = true;
+                        node.hash = leaves[i].hash;
+                        node.toPlay = leaves[i].toPlay;
+                        node.koPoint = leaves[i].koPoint;
+                    }
+
+                    // another leaf of the batch may have reached the node first
+                    if (not node.expanded and node.passes < 2){
+                        expand(node, leaves[i]);
+                    }
+
+                    backup(leaves[i]);
+                }
+            }
+
+            for (unsigned i = 0; i < count; i++){
+                games[i].endPlayout();
+            }
+        }
+    }
+
+}
@@ -0,0 +1,192 @@
+#ifndef SENTE_MCTS_H
+#define SENTE_MCTS_H
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+#include "GoGame.h"
+
+namespace sente {
+
+    /**
+     *
+     * formula used to choose which child of a node to search next
+     *
+     */
+    enum SelectionRule {
+        UCT, // upper confidence bounds applied to trees, ignores the priors
+        PUCT // the AlphaZero variant, which weights the exploration of each move by its prior
+    };
+
+    /**
+     *
+     * settings for a search
+     *
+     */
+    struct SearchOptions {
+        unsigned playouts = 1000; // number of positions to evaluate for each search
+        unsigned threads = 1; // number of threads to search with (0 uses one thread per core)
+        unsigned batchSize = 1; // number of positions each thread gathers before calling the evaluator
+        SelectionRule selection = UCT;
+        double exploration = 1.0;
+        double virtualLoss = 1.0; // losses added to a path while one of the threads is evaluating its leaf
+        uint64_t seed = 0;
+    };
+
+    /**
+     *
+     * the evaluation of a position
+     *
+     */
+    struct Evaluation {
+        // expected result for the player to move, from -1 (certain loss) to 1 (certain win)
+        double value = 0;
+        // prior for each point (x * side + y) followed by passing, left empty for uniform priors
+        std::vector<float> policy;
+    };
+
+    /**
+     *
+     * evaluates the leaves of a search. The games are in a playout at the positions to evaluate, so the evaluator may
+     * play moves on them. Evaluators are called from every search thread at once
+     *
+     */
+    class Evaluator {
+    public:
+
+        virtual ~Evaluator() = default;
+
+        virtual std::vector<Evaluation> evaluate(const std::vector<GoGame*>& games) = 0;
+
+    };
+
+    /**
+     *
+     * evaluates positions with a single random playout
+     *
+     */
+    class PlayoutEvaluator : public Evaluator {
+    public:
+
+        explicit PlayoutEvaluator(uint64_t seed, unsigned maxMoves = 0);
+
+        std::vector<Evaluation> evaluate(const std::vector<GoGame*>& games) override;
+
+    private:
+
+        uint64_t seed;
+        unsigned maxMoves;
+
+        // number of positions evaluated so far, each one gets its own stream of random numbers
+        std::atomic<uint64_t> evaluated{0};
+
+    };
+
+    /**
+     *
+     * search statistics of a move from the root
+     *
+     */
+    struct MoveStatistics {
+        Move move;
+        unsigned visits;
+        double value; // average result for the player making the move
+        double prior;
+    };
+
+    /**
+     *
+     * Monte Carlo tree search. The tree is kept between searches, so searching a position that follows the last one
+     * searched (after one or two moves) picks up the visits that the last search already spent on it
+     *
+     */
+    class MCTS {
+    public:
+
+        explicit MCTS(const SearchOptions& options, std::shared_ptr<Evaluator> evaluator = nullptr);
+
+        Move search(const GoGame& game);
+
+        [[nodiscard]] std::vector<MoveStatistics> getStatistics() const;
+        [[nodiscard]] unsigned getRootVisits() const;
+        [[nodiscard]] double getRootValue() const;
+
+        void clear();
+
+        [[nodiscard]] const SearchOptions& getOptions() const;
+
+    private:
+
+        struct Node {
+            Move move = Move::nullMove;
+            float prior = 0;
+
+            unsigned visits = 0;
+            unsigned inFlight = 0; // number of threads currently evaluating a leaf below this node
+            double valueSum = 0; // from the point of view of the player who made the move
+
+            // the position at the node, only known once a thread has reached it
+            bool reached = false;
+            uint64_t hash = 0;
+            Stone toPlay = EMPTY;
+            Vertex koPoint{0, 0};
+
+            unsigned passes = 0; // passes in a row ending with this node's move
+            bool expanded = false;
+            bool pruned = false; // the move turned out to be illegal, so the node is never searched
+
+            std::vector<Node> children;
+        };
+
+        /**
+         *
+         * a leaf being evaluated by one of the threads
+         *
+         */
+        struct Leaf {
+            std::vector<Node*> path;
+            GoGame* game = nullptr;
+
+            // the position at the leaf, recorded before the evaluator gets to play on the game
+            uint64_t hash = 0;
+            Stone toPlay = EMPTY;
+            Vertex koPoint{0, 0};
+            PointSet legal;
+
+            // node on the path whose move could not be played, if any
+            Node* illegal = nullptr;
+
+            Evaluation evaluation;
+        };
+
+        SearchOptions options;
+        std::shared_ptr<Evaluator> evaluator;
+
+        std::unique_ptr<Node> root;
+        unsigned rootSide = 0;
+        double rootKomi = 0;
+        Rules rootRules = CHINESE;
+
+        // only one search can run at a time
+        std::mutex searchLock;
+        // protects the tree while a search is running
+        mutable std::mutex treeLock;
+
+        void moveRoot(const GoGame& game);
+        static bool matches(const Node& node, const GoGame& game);
+
+        Node* selectChild(Node& node) const;
+        void selectLeaf(Leaf& leaf);
+        void expand(Node& node, const Leaf& leaf);
+        void backup(Leaf& leaf);
+
+        void runThread(std::vector<GoGame>& games, unsigned& started, bool& stop);
+
+    };
+
+}
+
+#endif //SENTE_MCTS_H
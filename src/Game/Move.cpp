@@ -2,11 +2,15 @@
 // Created by arthur wesley on 6/27/21.
 //
 
+#include <cstdint>
+#include <utility>
 #include <iostream>
+#include <stdexcept>
 
 #include "pybind11/pybind11.h"
 
 #include "Move.h"
+#include "Board.h"
 
 namespace py = pybind11;
 
@@ -46,6 +50,62 @@ namespace sente {
         return y;
     }
 
+    /**
+     *
+     * finds the point that a point moves to under one of the eight symmetries of the board. The board is first
+     * transposed if bit 2 of the symmetry is set, then flipped along the x axis if bit 0 is set and along the y axis if
+     * bit 1 is set. Symmetry 0 leaves every point where it is
+     *
+     * @param vertex point to transform
+     * @param symmetry index of the symmetry, from 0 to 7
+     * @param side side length of the board
+     * @return the transformed point
+     */
+    Vertex transformVertex(Vertex vertex, unsigned symmetry, unsigned side){
+
+        if (symmetry >= SYMMETRIES){
+            throw std::domain_error("the board only has " + std::to_string(SYMMETRIES) + " symmetries, got symmetry " +
+                                    std::to_string(symmetry));
+        }
+
+        unsigned x = vertex.getX();
+        unsigned y = vertex.getY();
+
+        if (symmetry & 4){
+            std::swap(x, y);
+        }
+        if (symmetry & 1){
+            x = side - 1 - x;
+        }
+        if (symmetry & 2){
+            y = side - 1 - y;
+        }
+
+        return {x, y};
+    }
+
+    /**
+     *
+     * finds the symmetry that undoes another, for mapping the output of a network that was given a transformed board
+     * back onto the real board
+     *
+     * @param symmetry index of the symmetry, from 0 to 7
+     * @return index of the inverse symmetry
+     */
+    unsigned invertSymmetry(unsigned symmetry){
+
+        if (symmetry >= SYMMETRIES){
+            throw std::domain_error("the board only has " + std::to_string(SYMMETRIES) + " symmetries, got symmetry " +
+                                    std::to_string(symmetry));
+        }
+
+        // the flips are undone before the transpose, which swaps the axis each flip applies to
+        if (symmetry & 4){
+            return 4 | ((symmetry & 1) << 1) | ((symmetry & 2) >> 1);
+        }
+        return symmetry;
+    }
+
     Stone getOpponent(Stone player){
         if (player == BLACK){
             return WHITE;
@@ -69,11 +129,12 @@ namespace sente {
         stone = EMPTY;
     }
 
-    const Move Move::passBlack = Move(19, 19, BLACK);
-    const Move Move::passWhite = Move(19, 19, WHITE);
+    // passing and resigning are stored just off the edge of the largest board so they never collide with a real point
+    const Move Move::passBlack = Move(MAX_BOARD_SIZE, MAX_BOARD_SIZE, BLACK);
+    const Move Move::passWhite = Move(MAX_BOARD_SIZE, MAX_BOARD_SIZE, WHITE);
 
-    const Move Move::resignBlack = Move(19, -1, BLACK);
-    const Move Move::resignWhite = Move(19, -1, WHITE);
+    const Move Move::resignBlack = Move(MAX_BOARD_SIZE, -1, BLACK);
+    const Move Move::resignWhite = Move(MAX_BOARD_SIZE, -1, WHITE);
 
     const Move Move::nullMove = Move();
 
@@ -233,17 +294,30 @@ namespace sente {
     void Move::flipOriginY(unsigned int side) {
         y = side - 1 - y;
     }
+
+    /**
+     *
+     * moves a move to the matching point of a rotated or reflected board (see transformVertex). Passes and
+     * resignations are left alone
+     *
+     * @param symmetry index of the symmetry, from 0 to 7
+     * @param side side length of the board
+     * @return the transformed move
+     */
+    Move Move::transform(unsigned symmetry, unsigned side) const {
+        if (isPass() or isResign()){
+            return *this;
+        }
+        return {transformVertex(getVertex(), symmetry, side), stone};
+    }
 }
 
 namespace std {
 
     size_t hash<sente::Move>::operator()(const sente::Move &move) const noexcept {
 
-        size_t hash1 = hash<unsigned>()(move.getX());
-        size_t hash2 = hash<unsigned>()(move.getX());
-        size_t hash3 = hash<unsigned>()(move.getStone());
-
-        return ((hash1 xor (hash2 << 1)) >> 1) xor (hash3 << 1);
+        // pack the move into one word, every point and color gets a distinct hash
+        return hash<uint64_t>()((uint64_t(move.getX()) << 34) | (uint64_t(move.getY()) << 2) | uint64_t(move.getStone()));
     }
 
     size_t std::hash<sente::Stone>::operator()(const sente::Stone &stone) const noexcept {
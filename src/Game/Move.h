@@ -43,6 +43,12 @@ namespace sente {
 
     Stone getOpponent(Stone player);
 
+    // number of rotations and reflections of the board
+    constexpr unsigned SYMMETRIES = 8;
+
+    Vertex transformVertex(Vertex vertex, unsigned symmetry, unsigned side);
+    unsigned invertSymmetry(unsigned symmetry);
+
     class Move {
     public:
 
@@ -83,6 +89,7 @@ namespace sente {
         std::string toSGF() const;
 
         void flipOriginY(unsigned side);
+        [[nodiscard]] Move transform(unsigned symmetry, unsigned side) const;
 
     private:
 
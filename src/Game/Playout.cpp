@@ -0,0 +1,203 @@
+#include <thread>
+#include <algorithm>
+#include <exception>
+
+#include "Playout.h"
+#include "Tactics.h"
+
+namespace sente {
+
+    /**
+     *
+     * scores a finished position from the point of view of one of the players
+     *
+     * @param game game to score
+     * @param player player to score the game for
+     * @return 1 if the player wins, -1 if the player loses and 0 for a draw
+     */
+    double getResultValue(const GoGame& game, Stone player){
+
+        PositionScore score = game.scorePosition();
+
+        double margin = player == BLACK ? score.black - score.white : score.white - score.black;
+
+        if (margin > 0){
+            return 1;
+        }
+        if (margin < 0){
+            return -1;
+        }
+        return 0;
+    }
+
+    /**
+     *
+     * plays random moves until both players pass or the move limit is reached. Moves are chosen uniformly from the
+     * legal moves that do not fill one of the player's own eyes, and a player with no such moves passes
+     *
+     * @param game game to play on (in a playout)
+     * @param random random number generator to choose moves with
+     * @param maxMoves the most moves to play
+     */
+    void playRandomMoves(GoGame& game, PlayoutRandom& random, unsigned maxMoves){
+
+        unsigned side = game.getSide();
+        unsigned passes = 0;
+
+        for (unsigned moves = 0; moves < maxMoves and passes < 2; moves++){
+
+            Stone player = game.getActivePlayer();
+            Move chosen = Move::pass(player);
+
+            PointSet candidates = game.getLegalPoints();
+            unsigned count = candidates.size();
+
+            while (count > 0){
+                Point point = candidates.select(random.below(count));
+                bool eye = game.visitState([&](const auto& state){
+                    return isEye(state.getGroups(), point, player);
+                });
+                // filling an eye is almost never a good move, so the playout policy never does it
+                if (not eye){
+                    chosen = Move(point / side, point % side, player);
+                    break;
+                }
+                // throw out eyes and draw again
+                candidates.erase(point);
+                count--;
+            }
+
+            game.tryPlay(chosen);
+            passes = chosen.isPass() ? passes + 1 : 0;
+        }
+    }
+
+    /**
+     *
+     * plays a batch of playouts on one thread
+     *
+     * @param game game to play on, only used by this thread
+     * @param playouts number of playouts to play
+     * @param seed seed for the random number generator of the thread
+     * @param maxMoves the most moves to play in each playout
+     * @return the totals of the playouts
+     */
+    PlayoutResults runThread(GoGame& game, unsigned playouts, uint64_t seed, unsigned maxMoves){
+
+        unsigned side = game.getSide();
+
+        PlayoutResults results;
+        results.playouts = playouts;
+        results.blackOwnership.resize(side * side);
+        results.whiteOwnership.resize(side * side);
+
+        PlayoutRandom random(seed);
+
+        for (unsigned i = 0; i < playouts; i++){
+
+            game.startPlayout();
+            playRandomMoves(game, random, maxMoves);
+
+            PositionScore score = game.scorePosition();
+
+            if (score.black > score.white){
+                results.blackWins++;
+            }
+            else if (score.white > score.black){
+                results.whiteWins++;
+            }
+
+            game.visitState([&](const auto& state){
+                state.getArea(BLACK).forEach([&](unsigned index){
+                    results.blackOwnership[index]++;
+                });
+                state.getArea(WHITE).forEach([&](unsigned index){
+                    results.whiteOwnership[index]++;
+                });
+            });
+
+            // take the playout back for the next one
+            game.endPlayout();
+        }
+
+        return results;
+    }
+
+    /**
+     *
+     * plays random games from the current position of a game and counts who wins them. The playouts are split
+     * evenly between the threads and each thread has its own copy of the game and its own random number generator,
+     * so the results only depend on the seed and the number of threads
+     *
+     * @param game game to play from (it is not changed)
+     * @param playouts number of playouts to play
+     * @param threads number of threads to use (0 uses one thread per core)
+     * @param seed seed for the random number generators
+     * @param maxMoves the most moves to play in each playout (0 allows three times the number of points on the board)
+     * @return the totals of the playouts
+     */
+    PlayoutResults runPlayouts(const GoGame& game, unsigned playouts, unsigned threads, uint64_t seed,
+                               unsigned maxMoves){
+
+        unsigned side = game.getSide();
+
+        if (threads == 0){
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        threads = std::max(1u, std::min(threads, playouts));
+
+        if (maxMoves == 0){
+            maxMoves = 3 * side * side;
+        }
+
+        // the copies are made up front because reading a game can update its internal caches
+        std::vector<GoGame> games;
+        games.reserve(threads);
+        for (unsigned thread = 0; thread < threads; thread++){
+            games.push_back(game.clone(false));
+        }
+
+        std::vector<PlayoutResults> partial(threads);
+        std::vector<std::exception_ptr> errors(threads);
+        std::vector<std::thread> workers;
+
+        for (unsigned thread = 0; thread < threads; thread++){
+            unsigned count = playouts / threads + (thread < playouts % threads);
+            workers.emplace_back([&, thread, count](){
+                try {
+                    partial[thread] = runThread(games[thread], count, seed + thread, maxMoves);
+                }
+                catch (...){
+                    errors[thread] = std::current_exception();
+                }
+            });
+        }
+
+        for (auto& worker : workers){
+            worker.join();
+        }
+
+        for (const auto& error : errors){
+            if (error){
+                std::rethrow_exception(error);
+            }
+        }
+
+        PlayoutResults results;
+        results.blackOwnership.resize(side * side);
+        results.whiteOwnership.resize(side * side);
+
+        for (const auto& part : partial){
+            results.playouts += part.playouts;
+            results.blackWins += part.blackWins;
+            results.whiteWins += part.whiteWins;
+            for (unsigned index = 0; index < part.blackOwnership.size(); index++){
+                results.blackOwnership[index] += part.blackOwnership[index];
+                results.whiteOwnership[index] += part.whiteOwnership[index];
+            }
+        }
+
+        return results;
+    }
+
+}
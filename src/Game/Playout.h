@@ -0,0 +1,61 @@
+#ifndef SENTE_PLAYOUT_H
+#define SENTE_PLAYOUT_H
+
+#include <vector>
+#include <cstdint>
+
+#include "GoGame.h"
+#include "Zobrist.h"
+
+namespace sente {
+
+    /**
+     *
+     * totals over a batch of random playouts
+     *
+     */
+    struct PlayoutResults {
+        unsigned playouts = 0;
+        unsigned blackWins = 0;
+        unsigned whiteWins = 0;
+
+        // number of playouts in which each point (x * side + y) ended up in the area of each player
+        std::vector<unsigned> blackOwnership;
+        std::vector<unsigned> whiteOwnership;
+    };
+
+    /**
+     *
+     * counter based random number generator (splitmix64). Each thread gets its own, so the playouts of a thread only
+     * depend on the seed
+     *
+     */
+    class PlayoutRandom {
+    public:
+
+        explicit PlayoutRandom(uint64_t seed) : counter(utils::mixBits(seed)) {}
+
+        /**
+         *
+         * @param bound number of possible values
+         * @return random number from 0 up to (but not including) the bound
+         */
+        unsigned below(unsigned bound){
+            return unsigned(utils::mixBits(counter++) % bound);
+        }
+
+    private:
+
+        uint64_t counter;
+
+    };
+
+    double getResultValue(const GoGame& game, Stone player);
+    void playRandomMoves(GoGame& game, PlayoutRandom& random, unsigned maxMoves);
+
+    PlayoutResults runPlayouts(const GoGame& game, unsigned playouts, unsigned threads, uint64_t seed,
+                               unsigned maxMoves = 0);
+
+}
+
+#endif //SENTE_PLAYOUT_H
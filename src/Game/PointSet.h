@@ -0,0 +1,135 @@
+#ifndef SENTE_POINTSET_H
+#define SENTE_POINTSET_H
+
+#include <array>
+#include <cstdint>
+#include <ciso646>
+
+#include "Board.h"
+#include "Bitboard.h"
+
+namespace sente {
+
+    // index of a point on a board of a given side, the point (x, y) has the index x * side + y
+    typedef uint16_t Point;
+
+    inline Point toPoint(unsigned x, unsigned y, unsigned side){
+        return Point(x * side + y);
+    }
+
+    /**
+     *
+     * A set of points on a board of any supported size.
+     *
+     * The set has room for every point of the largest board, so it never allocates. Points are stored with the same
+     * indexing as Bitboard<side>, which lets a statically sized Bitboard be copied into it directly.
+     *
+     */
+    class PointSet {
+    public:
+
+        static constexpr unsigned capacity = MAX_BOARD_SIZE * MAX_BOARD_SIZE;
+        static constexpr unsigned words = (capacity + 63) / 64;
+
+        PointSet() : bits{} {}
+
+        template<unsigned side>
+        explicit PointSet(const Bitboard<side>& points) : bits{} {
+            points.forEach([&](unsigned index){
+                insert(Point(index));
+            });
+        }
+
+        [[nodiscard]] bool contains(Point point) const {
+            return (bits[point >> 6] >> (point & 63)) & 1;
+        }
+        void insert(Point point){
+            bits[point >> 6] |= uint64_t(1) << (point & 63);
+        }
+        void erase(Point point){
+            bits[point >> 6] &= ~(uint64_t(1) << (point & 63));
+        }
+        void clear(){
+            bits = {};
+        }
+
+        [[nodiscard]] bool empty() const {
+            for (const auto& word : bits){
+                if (word){
+                    return false;
+                }
+            }
+            return true;
+        }
+        [[nodiscard]] unsigned size() const {
+            unsigned total = 0;
+            for (const auto& word : bits){
+                total += popCount(word);
+            }
+            return total;
+        }
+
+        /**
+         *
+         * finds a point by its position in the set
+         *
+         * @param rank number of points in the set that come before the point (must be less than the size of the set)
+         * @return the point
+         */
+        [[nodiscard]] Point select(unsigned rank) const {
+            for (unsigned i = 0; i < words; i++){
+                uint64_t word = bits[i];
+                unsigned count = popCount(word);
+                if (rank >= count){
+                    rank -= count;
+                    continue;
+                }
+                // drop the lower points of the word until the one we want is the lowest
+                for (; rank > 0; rank--){
+                    word &= word - 1;
+                }
+                return Point(i * 64 + lowestBit(word));
+            }
+            return Point(capacity);
+        }
+
+        /**
+         *
+         * calls a function on every point in the set in ascending order
+         *
+         * @param function function to call on each point
+         */
+        template<typename Function>
+        void forEach(Function function) const {
+            for (unsigned i = 0; i < words; i++){
+                uint64_t word = bits[i];
+                while (word){
+                    function(Point(i * 64 + lowestBit(word)));
+                    word &= word - 1;
+                }
+            }
+        }
+
+        PointSet& operator|=(const PointSet& other){
+            for (unsigned i = 0; i < words; i++){
+                bits[i] |= other.bits[i];
+            }
+            return *this;
+        }
+
+        bool operator==(const PointSet& other) const {
+            return bits == other.bits;
+        }
+        bool operator!=(const PointSet& other) const {
+            return bits != other.bits;
+        }
+
+    private:
+
+        std::array<uint64_t, words> bits;
+
+    };
+
+}
+
+#endif //SENTE_POINTSET_H
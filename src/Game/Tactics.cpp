@@ -0,0 +1,306 @@
+#include <array>
+#include <algorithm>
+
+#include "Tactics.h"
+
+namespace sente {
+
+    bool isCapturedInLadder(const GroupTable& groups, unsigned prey, unsigned& budget);
+    bool escapesLadder(const GroupTable& groups, unsigned prey, unsigned& budget);
+
+    /**
+     *
+     * works out what a move on an empty point would do without playing it
+     *
+     * @param groups chains of stones on the board
+     * @param index point to play on
+     * @param color color of the stone to play
+     * @return the chain the move would become part of and the number of stones it would capture
+     */
+    MoveOutcome getMoveOutcome(const GroupTable& groups, unsigned index, Stone color){
+
+        PointSet liberties;
+        unsigned chainSize = 1;
+        unsigned captured = 0;
+
+        groups.forEachNeighbor(index, [&](unsigned neighbor){
+            if (groups.getStone(neighbor) == EMPTY){
+                liberties.insert(neighbor);
+            }
+        });
+
+        std::array<unsigned, 4> friends{};
+        unsigned friendCount = 0;
+
+        groups.forEachAdjacentChain(index, color, [&](unsigned root){
+            liberties |= groups.getLiberties(root);
+            chainSize += groups.getStoneCount(root);
+            friends[friendCount++] = root;
+        });
+
+        auto inChain = [&](unsigned point){
+            return point == index or (groups.getStone(point) == color and
+                   std::find(friends.begin(), friends.begin() + friendCount, groups.find(point)) !=
+                   friends.begin() + friendCount);
+        };
+
+        // the stones of a captured chain become liberties wherever they touch the new chain
+        groups.forEachCapturedChain(index, color, [&](unsigned root){
+            captured += groups.getStoneCount(root);
+            groups.forEachStone(root, [&](unsigned stone){
+                bool touches = false;
+                groups.forEachNeighbor(stone, [&](unsigned neighbor){
+                    touches = touches or inChain(neighbor);
+                });
+                if (touches){
+                    liberties.insert(stone);
+                }
+            });
+        });
+
+        liberties.erase(index);
+
+        return {liberties.size(), chainSize, captured};
+    }
+
+    /**
+     *
+     * places a stone and removes the enemy chains it captures. Ko is not checked, which is enough for reading out
+     * ladders
+     *
+     * @param groups chains of stones on the board
+     * @param index point to play on
+     * @param color color of the stone to play
+     * @return whether the stone could be placed (the point is empty and the move is not a self-capture)
+     */
+    bool placeAndCapture(GroupTable& groups, unsigned index, Stone color){
+
+        if (groups.getStone(index) != EMPTY or groups.isSelfCapture(index, color)){
+            return false;
+        }
+
+        groups.placeStone(index, color);
+
+        groups.forEachAdjacentChain(index, getOpponent(color), [&](unsigned root){
+            if (not groups.hasLiberties(root)){
+                groups.removeChain(root);
+            }
+        });
+
+        return true;
+    }
+
+    /**
+     *
+     * determines whether an empty point is an eye of a color: every neighbor is one of its stones and the enemy does
+     * not hold enough of the diagonals to make the eye false
+     *
+     * @param groups chains of stones on the board
+     * @param index point to check
+     * @param color color to check for
+     * @return whether the point is an eye
+     */
+    bool isEye(const GroupTable& groups, unsigned index, Stone color){
+
+        if (groups.getStone(index) != EMPTY){
+            return false;
+        }
+
+        bool surrounded = true;
+        groups.forEachNeighbor(index, [&](unsigned neighbor){
+            surrounded = surrounded and groups.getStone(neighbor) == color;
+        });
+
+        if (not surrounded){
+            return false;
+        }
+
+        int side = int(groups.getSide());
+        int x = int(index) / side;
+        int y = int(index) % side;
+
+        unsigned offBoard = 0;
+        unsigned enemies = 0;
+
+        for (int dx : {-1, 1}){
+            for (int dy : {-1, 1}){
+                if (x + dx < 0 or y + dy < 0 or x + dx >= side or y + dy >= side){
+                    offBoard++;
+                }
+                else if (groups.getStone(groups.toIndex(x + dx, y + dy)) == getOpponent(color)){
+                    enemies++;
+                }
+            }
+        }
+
+        // an eye on the edge of the board is false if the enemy holds any diagonal, elsewhere it takes two
+        return enemies + (offBoard > 0 ? 1 : 0) < 2;
+    }
+
+    /**
+     *
+     * reads out whether a chain in atari is captured in a ladder when its owner is to move. The chain may run from its
+     * last liberty or capture an attacking chain that is in atari
+     *
+     * @param groups chains of stones on the board
+     * @param prey a stone of the chain in atari
+     * @param budget number of positions left to read, shared by the whole search
+     * @return whether every way out of atari fails
+     */
+    bool isCapturedInLadder(const GroupTable& groups, unsigned prey, unsigned& budget){
+
+        Stone color = groups.getStone(prey);
+
+        PointSet escapes = groups.getLiberties(prey);
+
+        groups.forEachStone(prey, [&](unsigned stone){
+            groups.forEachNeighbor(stone, [&](unsigned neighbor){
+                if (groups.getStone(neighbor) == getOpponent(color) and groups.countLiberties(neighbor) == 1){
+                    escapes |= groups.getLiberties(neighbor);
+                }
+            });
+        });
+
+        bool captured = true;
+
+        escapes.forEach([&](Point point){
+            if (not captured){
+                return;
+            }
+            if (budget == 0){
+                // reading too far counts as an escape, so the feature only marks ladders that are sure to work
+                captured = false;
+                return;
+            }
+            budget--;
+
+            // most ways out are settled by the number of liberties they leave, without copying the table
+            if (groups.isSelfCapture(point, color)){
+                return;
+            }
+            unsigned liberties = getMoveOutcome(groups, point, color).liberties;
+            if (liberties != 2){
+                captured = liberties < 2;
+                return;
+            }
+
+            GroupTable next = groups;
+            if (placeAndCapture(next, point, color) and escapesLadder(next, prey, budget)){
+                captured = false;
+            }
+        });
+
+        return captured;
+    }
+
+    /**
+     *
+     * reads out whether a chain survives a ladder when the attacker is to move. A chain with two liberties can be put
+     * back in atari from either side
+     *
+     * @param groups chains of stones on the board
+     * @param prey a stone of the chain being chased
+     * @param budget number of positions left to read, shared by the whole search
+     * @return whether the attacker can't capture the chain with a ladder
+     */
+    bool escapesLadder(const GroupTable& groups, unsigned prey, unsigned& budget){
+
+        unsigned liberties = groups.countLiberties(prey);
+
+        if (liberties != 2){
+            return liberties > 2;
+        }
+
+        Stone attacker = getOpponent(groups.getStone(prey));
+
+        bool escapes = true;
+
+        groups.getLiberties(prey).forEach([&](Point point){
+            if (not escapes or budget == 0){
+                return;
+            }
+            budget--;
+            GroupTable next = groups;
+            if (placeAndCapture(next, point, attacker) and next.countLiberties(prey) == 1 and
+                isCapturedInLadder(next, prey, budget)){
+                escapes = false;
+            }
+        });
+
+        return escapes;
+    }
+
+    /**
+     *
+     * determines whether a move puts an enemy chain in atari that can't get out of a ladder
+     *
+     * @param groups chains of stones on the board
+     * @param index point to play on
+     * @param color color of the stone to play
+     * @return whether the move captures a chain in a ladder
+     */
+    bool isLadderCapture(const GroupTable& groups, unsigned index, Stone color){
+
+        if (groups.getStone(index) != EMPTY){
+            return false;
+        }
+
+        // only a move that takes an enemy chain from two liberties to one starts a ladder
+        bool ataris = false;
+        groups.forEachAdjacentChain(index, getOpponent(color), [&](unsigned root){
+            ataris = ataris or groups.countLiberties(root) == 2;
+        });
+
+        if (not ataris){
+            return false;
+        }
+
+        GroupTable next = groups;
+        if (not placeAndCapture(next, index, color)){
+            return false;
+        }
+
+        unsigned budget = LADDER_BUDGET;
+
+        bool captures = false;
+        next.forEachAdjacentChain(index, getOpponent(color), [&](unsigned root){
+            captures = captures or (next.countLiberties(root) == 1 and isCapturedInLadder(next, root, budget));
+        });
+
+        return captures;
+    }
+
+    /**
+     *
+     * determines whether a move runs a chain in atari out of a ladder
+     *
+     * @param groups chains of stones on the board
+     * @param index point to play on
+     * @param color color of the stone to play
+     * @return whether the move saves a chain in atari from being captured in a ladder
+     */
+    bool isLadderEscape(const GroupTable& groups, unsigned index, Stone color){
+
+        if (groups.getStone(index) != EMPTY){
+            return false;
+        }
+
+        bool inAtari = false;
+        groups.forEachAdjacentChain(index, color, [&](unsigned root){
+            inAtari = inAtari or groups.isLastLiberty(root, index);
+        });
+
+        if (not inAtari){
+            return false;
+        }
+
+        GroupTable next = groups;
+        if (not placeAndCapture(next, index, color)){
+            return false;
+        }
+
+        unsigned budget = LADDER_BUDGET;
+        return escapesLadder(next, index, budget);
+    }
+
+}
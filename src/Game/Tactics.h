@@ -0,0 +1,35 @@
+#ifndef SENTE_TACTICS_H
+#define SENTE_TACTICS_H
+
+#include <ciso646>
+
+#include "GroupTable.h"
+
+namespace sente {
+
+    /**
+     *
+     * what a move on an empty point would do to the chains around it
+     *
+     */
+    struct MoveOutcome {
+        unsigned liberties; // liberties of the chain the move becomes part of
+        unsigned chainSize; // stones in the chain the move becomes part of
+        unsigned captured; // enemy stones the move captures
+    };
+
+    // number of positions a ladder is read out to before the chain is assumed to escape
+    constexpr unsigned LADDER_BUDGET = 1000;
+
+    MoveOutcome getMoveOutcome(const GroupTable& groups, unsigned index, Stone color);
+
+    bool placeAndCapture(GroupTable& groups, unsigned index, Stone color);
+
+    bool isEye(const GroupTable& groups, unsigned index, Stone color);
+
+    bool isLadderCapture(const GroupTable& groups, unsigned index, Stone color);
+    bool isLadderEscape(const GroupTable& groups, unsigned index, Stone color);
+
+}
+
+#endif //SENTE_TACTICS_H
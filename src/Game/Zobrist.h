@@ -0,0 +1,52 @@
+#ifndef SENTE_ZOBRIST_H
+#define SENTE_ZOBRIST_H
+
+#include <cstdint>
+
+#include "Move.h"
+
+namespace sente::utils {
+
+    /**
+     *
+     * splitmix64 finalizer, used to turn a small integer into a well mixed 64-bit key
+     *
+     * @param value value to mix
+     * @return mixed 64-bit value
+     */
+    inline uint64_t mixBits(uint64_t value){
+        value += 0x9e3779b97f4a7c15ULL;
+        value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+        return value ^ (value >> 31);
+    }
+
+    /**
+     *
+     * obtains the Zobrist key of a stone on a given point. Keys only depend on the co-ordinates and the color of the
+     * stone, so they are the same for every game and every board size.
+     *
+     * @param move stone to get the key of
+     * @return 64-bit key for the stone (0 for an empty point)
+     */
+    inline uint64_t getZobristKey(const Move& move){
+        if (move.getStone() == EMPTY){
+            return 0;
+        }
+        return mixBits((uint64_t(move.getX()) << 16) | (uint64_t(move.getY()) << 8) | uint64_t(move.getStone()));
+    }
+
+    /**
+     *
+     * obtains the key that is mixed into a position hash to record which player is to move (situational superko)
+     *
+     * @param player the player to move
+     * @return 64-bit key for the player
+     */
+    inline uint64_t getZobristKey(Stone player){
+        return player == WHITE ? mixBits(0xffffffffULL) : 0;
+    }
+
+}
+
+#endif //SENTE_ZOBRIST_H
@@ -0,0 +1,206 @@
+#include <algorithm>
+
+#include "Numpy.h"
+#include "PythonEvaluator.h"
+#include "EvaluationQueue.h"
+
+namespace sente::utils {
+
+    /**
+     *
+     * @param function function that takes an array of features with the shape (batch, side, side, planes) and
+     * returns a tuple of the policy, with the shape (batch, side * side + 1), and the value of each position
+     * @param features names of the features to pass to the function (see getFeatures)
+     * @param maxBatchSize the most positions to send to the function at once
+     * @param maxDelay the longest time a position waits for the batch to fill up
+     */
+    EvaluationQueue::EvaluationQueue(py::function function, std::vector<std::string> features, unsigned maxBatchSize,
+                                     std::chrono::microseconds maxDelay)
+        : function(std::move(function)), features(std::move(features)), maxBatchSize(maxBatchSize),
+          maxDelay(maxDelay){
+        if (maxBatchSize == 0){
+            throw std::domain_error("batches must have room for at least one position");
+        }
+    }
+
+    /**
+     *
+     * adds positions to the queue and waits for them to be evaluated. If no batch is being filled, the caller fills
+     * and sends the next one itself. Must be called without holding the GIL
+     *
+     * @param games games at the positions to evaluate, which must all be played on the same board size
+     * @return the policy and value of each position
+     */
+    std::vector<Evaluation> EvaluationQueue::evaluate(const std::vector<GoGame*>& games){
+
+        if (games.empty()){
+            return {};
+        }
+
+        // the batch is laid out by the board size of each request's first game
+        checkBoardSizes(games);
+
+        Request request;
+        request.games = &games;
+        request.queuedAt = std::chrono::steady_clock::now();
+
+        std::unique_lock<std::mutex> guard(queueLock);
+
+        queue.push_back(&request);
+        queued += games.size();
+        changed.notify_all();
+
+        while (not request.done){
+            if (dispatching){
+                changed.wait(guard);
+            }
+            else {
+                dispatch(guard);
+            }
+        }
+
+        guard.unlock();
+
+        if (request.error){
+            std::rethrow_exception(request.error);
+        }
+
+        return std::move(request.evaluations);
+    }
+
+    unsigned EvaluationQueue::getMaxBatchSize() const {
+        return maxBatchSize;
+    }
+
+    /**
+     *
+     * @return the number of batches sent to the python function so far
+     */
+    unsigned EvaluationQueue::getBatches() const {
+        std::lock_guard<std::mutex> guard(queueLock);
+        return batches;
+    }
+
+    /**
+     *
+     * @return the number of positions evaluated so far
+     */
+    unsigned EvaluationQueue::getPositions() const {
+        std::lock_guard<std::mutex> guard(queueLock);
+        return positions;
+    }
+
+    /**
+     *
+     * waits for the batch to fill up (or for the oldest position's deadline), then takes as many requests for the
+     * same board size as fit in the batch off of the queue and evaluates them
+     *
+     * @param guard lock on the queue, held when the function is called and when it returns
+     */
+    void EvaluationQueue::dispatch(std::unique_lock<std::mutex>& guard){
+
+        dispatching = true;
+
+        changed.wait_until(guard, queue.front()->queuedAt + maxDelay, [&](){
+            return queued >= maxBatchSize;
+        });
+
+        unsigned side = queue.front()->games->front()->getSide();
+
+        std::vector<Request*> batch;
+        unsigned size = 0;
+
+        for (auto request = queue.begin(); request != queue.end();){
+
+            unsigned count = (*request)->games->size();
+
+            // a single request larger than a batch is still sent on its own
+            if (not batch.empty() and size + count > maxBatchSize){
+                break;
+            }
+            if ((*request)->games->front()->getSide() != side){
+                request++;
+                continue;
+            }
+
+            batch.push_back(*request);
+            size += count;
+            request = queue.erase(request);
+        }
+
+        queued -= size;
+
+        guard.unlock();
+        runBatch(batch);
+        guard.lock();
+
+        for (auto* request : batch){
+            request->done = true;
+        }
+
+        batches++;
+        positions += size;
+
+        dispatching = false;
+        changed.notify_all();
+    }
+
+    /**
+     *
+     * writes the features of a batch of requests into the batch buffer, calls the python function once and hands the
+     * results back to each request
+     *
+     * @param batch requests to evaluate, all on boards of the same size
+     */
+    void EvaluationQueue::runBatch(const std::vector<Request*>& batch){
+
+        try {
+
+            py::gil_scoped_acquire acquire;
+
+            long side = long(batch.front()->games->front()->getSide());
+            long depth = long(countPlanes(features));
+
+            long size = 0;
+            for (auto* request : batch){
+                size += long(request->games->size());
+            }
+
+            // the buffer is only reallocated when the board size changes or a request outgrows it
+            if (side != bufferSide or size > bufferCapacity){
+                bufferCapacity = std::max(size, long(maxBatchSize));
+                bufferSide = side;
+                buffer = py::array_t<uint8_t>({bufferCapacity, side, side, depth});
+            }
+
+            uint8_t* data = buffer.mutable_data();
+
+            long row = 0;
+            for (auto* request : batch){
+                for (auto* game : *request->games){
+                    writeFeatures(*game, features, data + row * side * side * depth);
+                    row++;
+                }
+            }
+
+            // view of the rows that were filled in, which keeps the buffer alive
+            py::array_t<uint8_t> input({size, side, side, depth}, data, buffer);
+
+            auto evaluations = readEvaluations(function(input), size, side);
+
+            auto next = evaluations.begin();
+            for (auto* request : batch){
+                request->evaluations.assign(std::make_move_iterator(next),
+                                            std::make_move_iterator(next + long(request->games->size())));
+                next += long(request->games->size());
+            }
+        }
+        catch (...){
+            auto error = std::current_exception();
+            for (auto* request : batch){
+                request->error = error;
+            }
+        }
+    }
+
+}
@@ -0,0 +1,80 @@
+#ifndef SENTE_EVALUATIONQUEUE_H
+#define SENTE_EVALUATIONQUEUE_H
+
+#include <mutex>
+#include <deque>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <exception>
+#include <condition_variable>
+
+#include <pybind11/numpy.h>
+
+#include "../Game/MCTS.h"
+
+namespace sente::utils {
+
+    /**
+     *
+     * collects the positions that many threads (or searches) need evaluated into batches, so that the python function
+     * is called once for a whole batch. A caller waits until its positions have been evaluated. Batches are sent
+     * once they are full or once the oldest position has waited for the longest delay
+     *
+     */
+    class EvaluationQueue : public Evaluator {
+    public:
+
+        EvaluationQueue(py::function function, std::vector<std::string> features, unsigned maxBatchSize,
+                        std::chrono::microseconds maxDelay);
+
+        std::vector<Evaluation> evaluate(const std::vector<GoGame*>& games) override;
+
+        [[nodiscard]] unsigned getMaxBatchSize() const;
+        [[nodiscard]] unsigned getBatches() const;
+        [[nodiscard]] unsigned getPositions() const;
+
+    private:
+
+        /**
+         *
+         * positions from one caller, waiting to be evaluated
+         *
+         */
+        struct Request {
+            const std::vector<GoGame*>* games;
+            std::chrono::steady_clock::time_point queuedAt;
+            std::vector<Evaluation> evaluations;
+            bool done = false;
+            std::exception_ptr error;
+        };
+
+        py::function function;
+        std::vector<std::string> features;
+        unsigned maxBatchSize;
+        std::chrono::microseconds maxDelay;
+
+        mutable std::mutex queueLock;
+        std::condition_variable changed;
+        std::deque<Request*> queue;
+        unsigned queued = 0; // number of positions waiting in the queue
+
+        // whether one of the callers is currently filling and sending a batch
+        bool dispatching = false;
+
+        // the batch that features are written into, only used while holding the GIL
+        py::array_t<uint8_t> buffer;
+        long bufferSide = 0;
+        long bufferCapacity = 0;
+
+        unsigned batches = 0;
+        unsigned positions = 0;
+
+        void dispatch(std::unique_lock<std::mutex>& guard);
+        void runBatch(const std::vector<Request*>& batch);
+
+    };
+
+}
+
+#endif //SENTE_EVALUATIONQUEUE_H
@@ -77,6 +77,39 @@ namespace sente::GTP {
         registerCommand("genmove", std::bind(&DefaultSession::genMove, this, _1), {{"operation", STRING}, {"color", COLOR}});
     }
 
+    /**
+     *
+     * makes genmove use a built-in search, which takes the place of any genmove function registered from python.
+     * Removing the search puts the python function back
+     *
+     * @param newSearch search to generate moves with (or nullptr to go back to the genmove function from python)
+     */
+    void DefaultSession::setSearch(std::shared_ptr<MCTS> newSearch){
+
+        search = std::move(newSearch);
+
+        if (not search){
+            // the built-in genmove falls back on the python function by itself
+            return;
+        }
+
+        using namespace std::placeholders;
+        auto builtIn = std::bind(&DefaultSession::genMove, this, _1);
+
+        for (const auto& command : commands["genmove"]){
+            if (command.second.size() == 2 and command.second[1].second == COLOR and
+                not command.first.target<decltype(builtIn)>()){
+                fallbackGenMove = command.first;
+            }
+        }
+
+        registerCommand("genmove", builtIn, {{"operation", STRING}, {"color", COLOR}});
+    }
+
+    std::shared_ptr<MCTS> DefaultSession::getSearch() const {
+        return search;
+    }
+
     void DefaultSession::registerCommand(const std::string& commandName, CommandMethod method,
                                   std::vector<ArgumentPattern> argumentPattern){
         // raise an exception if the command is non-modifiable
@@ -135,9 +168,9 @@ namespace sente::GTP {
     Response DefaultSession::boardSize(const std::vector<std::shared_ptr<Token>>& arguments){
         // reset the board
         auto* size = (Integer*) arguments[1].get();
-        if (size->getValue() == 9 or size->getValue() == 13 or size->getValue() == 19){
+        if (MIN_BOARD_SIZE <= size->getValue() and size->getValue() <= MAX_BOARD_SIZE){
             masterGame = GoGame(size->getValue(), masterGame.getRules(), masterGame.getKomi(),
-                                      {sente::Move::nullMove});
+                                      {sente::Move::nullMove}, masterGame.getKoRule());
             setGTPDisplayFlags();
             return {true, ""};
         }
@@ -186,8 +219,32 @@ namespace sente::GTP {
         }
     }
     Response DefaultSession::genMove(const std::vector<std::shared_ptr<Token>>& arguments){
-        (void) arguments;
-        throw std::runtime_error("genmove has not been implemented by this engine, please register a valid function");
+
+        if (not search){
+            if (fallbackGenMove){
+                return fallbackGenMove(arguments);
+            }
+            throw std::runtime_error("genmove has not been implemented by this engine, please register a valid function");
+        }
+
+        auto* color = (Color*) arguments[1].get();
+
+        // generate the move for the requested color, even if it is not their turn
+        if (color->getStone() != masterGame.getActivePlayer()){
+            masterGame.setActivePlayer(color->getStone());
+        }
+
+        sente::Move move;
+
+        {
+            // the search threads need the GIL to call a python evaluator
+            py::gil_scoped_release release;
+            move = search->search(masterGame);
+        }
+
+        masterGame.playStone(move);
+
+        return {true, moveToVertex(move, masterGame.getSide())};
     }
     Response DefaultSession::showBoard(const std::vector<std::shared_ptr<Token>>& arguments){
         (void) arguments;
@@ -6,6 +6,7 @@
 #define SENTE_OPERATORS_H
 
 #include "Session.h"
+#include "../../Game/MCTS.h"
 
 namespace sente::GTP {
 
@@ -18,8 +19,16 @@ namespace sente::GTP {
 
         DefaultSession(const std::string& engineName, const std::string& engineVersion);
 
+        void setSearch(std::shared_ptr<MCTS> newSearch);
+        [[nodiscard]] std::shared_ptr<MCTS> getSearch() const;
+
     private:
 
+        // built-in search used by genmove, if the engine uses one
+        std::shared_ptr<MCTS> search;
+        // genmove function registered from python before the search, which genmove goes back to without a search
+        CommandMethod fallbackGenMove;
+
         void registerCommand(const std::string& commandName, CommandMethod method,
                              std::vector<ArgumentPattern> argumentPattern);
 
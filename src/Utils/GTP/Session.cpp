@@ -403,37 +403,47 @@ namespace sente::GTP {
                 masterGame.addStones({*move});
             }
 
-            std::string message;
+            return {true, moveToVertex(*move, masterGame.getSide())};
 
-            if (move->isPass()){
-                message = "pass";
-            }
-            else if (move->isResign()){
-                message = "resign";
-            }
-            else {
-                char first;
+        };
 
-                // determine the letter
-                if (move->getX() + 'A' < 'I'){
-                    first = 'A' + move->getX();
-                }
-                else {
-                    first = 'B' + move->getX();
-                }
+        registerCommand("genmove", wrapper, argumentPattern);
 
-                // add the letter to the second co-ord
-                message = std::to_string(masterGame.getSide() - move->getY());
-                message.insert(message.begin(), first);
-            }
+        return function;
+    }
+
+    /**
+     *
+     * converts a move into the vertex that a GTP engine responds to genmove with
+     *
+     * @param move move to convert
+     * @param side side length of the board
+     * @return the GTP vertex of the move, "pass" or "resign"
+     */
+    std::string Session::moveToVertex(const sente::Move& move, unsigned side){
 
-            return {true, message};
+        if (move.isPass()){
+            return "pass";
+        }
+        if (move.isResign()){
+            return "resign";
+        }
 
-        };
+        char first;
 
-        registerCommand("genmove", wrapper, argumentPattern);
+        // determine the letter
+        if (move.getX() + 'A' < 'I'){
+            first = 'A' + move.getX();
+        }
+        else {
+            first = 'B' + move.getX();
+        }
 
-        return function;
+        // add the letter to the second co-ord
+        std::string message = std::to_string(side - move.getY());
+        message.insert(message.begin(), first);
+
+        return message;
     }
 
     std::string Session::getEngineName() const {
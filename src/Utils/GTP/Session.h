@@ -75,6 +75,8 @@ namespace sente::GTP {
 
         Response execute(const std::string& command, const std::vector<std::shared_ptr<Token>>& arguments);
 
+        static std::string moveToVertex(const sente::Move& move, unsigned side);
+
         static std::string errorMessage(const std::string& message) ;
         static std::string errorMessage(const std::string& message, unsigned i) ;
         static std::string statusMessage(const std::string& message) ;
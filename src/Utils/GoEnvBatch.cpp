@@ -0,0 +1,196 @@
+#include <thread>
+#include <algorithm>
+#include <stdexcept>
+
+#include "Numpy.h"
+#include "Parallel.h"
+#include "GoEnvBatch.h"
+#include "../Game/Playout.h"
+
+namespace sente::utils {
+
+    /**
+     *
+     * @param count number of games to play at once
+     * @param side side length of the boards
+     * @param rules rules to play the games by
+     * @param komi komi of the games
+     * @param koRule rule used to prevent repeated positions
+     * @param features names of the features that make up the observations (see getFeatures)
+     * @param maxMoves moves after which a game is scored even if the players have not passed (0 allows twice the
+     * number of points on the board)
+     * @param threads number of threads to step the games on (0 uses one thread per core)
+     */
+    GoEnvBatch::GoEnvBatch(unsigned count, unsigned side, Rules rules, double komi, KoRule koRule,
+                           std::vector<std::string> features, unsigned maxMoves, unsigned threads)
+        : side(side), features(std::move(features)), planes(countPlanes(this->features)),
+          maxMoves(maxMoves == 0 ? 2 * side * side : maxMoves),
+          threads(threads == 0 ? std::max(1u, std::thread::hardware_concurrency()) : threads){
+
+        if (count == 0){
+            throw std::domain_error("a batch of games must have at least one game");
+        }
+
+        games.reserve(count);
+        for (unsigned i = 0; i < count; i++){
+            games.emplace_back(side, rules, komi, std::unordered_set<Move>{Move::nullMove}, koRule);
+            games.back().startPlayout();
+        }
+
+        moveCounts.assign(count, 0);
+
+        observations.assign(count * side * side * planes, 0);
+        legalMasks.assign(count * (side * side + 1), 0);
+        rewards.assign(count, 0);
+        done.assign(count, 0);
+
+        reset();
+    }
+
+    /**
+     *
+     * starts every game over
+     *
+     */
+    void GoEnvBatch::reset(){
+
+        parallelFor(games.size(), threads, [&](unsigned index){
+            restart(index);
+            observe(index);
+            rewards[index] = 0;
+            done[index] = 0;
+        });
+
+    }
+
+    /**
+     *
+     * plays one action in every game. Games that end (by two passes in a row or by reaching the move limit) are
+     * scored, reported as done and started over, so their observation is the start of the next game
+     *
+     * @param actions action for each game, the point x * side + y or side * side to pass
+     */
+    void GoEnvBatch::step(const std::vector<int64_t>& actions){
+
+        if (actions.size() != games.size()){
+            throw std::domain_error("expected " + std::to_string(games.size()) + " actions, got " +
+                                    std::to_string(actions.size()));
+        }
+
+        // check every action before playing any of them, so that an illegal action leaves every game alone
+        for (unsigned index = 0; index < games.size(); index++){
+            if (actions[index] < 0 or actions[index] > side * side){
+                throw std::out_of_range("action " + std::to_string(actions[index]) + " of game " +
+                                        std::to_string(index) + " is not on the board");
+            }
+            if (not legalMasks[index * (side * side + 1) + actions[index]]){
+                throw std::domain_error("action " + std::to_string(actions[index]) + " of game " +
+                                        std::to_string(index) + " is illegal");
+            }
+        }
+
+        parallelFor(games.size(), threads, [&](unsigned index){
+            stepGame(index, actions[index]);
+        });
+
+    }
+
+    unsigned GoEnvBatch::getCount() const {
+        return games.size();
+    }
+
+    unsigned GoEnvBatch::getSide() const {
+        return side;
+    }
+
+    unsigned GoEnvBatch::getFeatureCount() const {
+        return planes;
+    }
+
+    const GoGame& GoEnvBatch::getGame(unsigned index) const {
+        if (index >= games.size()){
+            throw std::out_of_range("game " + std::to_string(index) + " is not in a batch of " +
+                                    std::to_string(games.size()) + " games");
+        }
+        return games[index];
+    }
+
+    const std::vector<uint8_t>& GoEnvBatch::getObservations() const {
+        return observations;
+    }
+
+    const std::vector<uint8_t>& GoEnvBatch::getLegalMasks() const {
+        return legalMasks;
+    }
+
+    const std::vector<float>& GoEnvBatch::getRewards() const {
+        return rewards;
+    }
+
+    const std::vector<uint8_t>& GoEnvBatch::getDone() const {
+        return done;
+    }
+
+    /**
+     *
+     * writes the observation and legal move mask of a game into the buffers
+     *
+     * @param index index of the game
+     */
+    void GoEnvBatch::observe(unsigned index){
+
+        writeFeatures(games[index], features, observations.data() + index * side * side * planes);
+
+        const auto& mask = games[index].getLegalMask();
+        std::copy(mask.begin(), mask.end(), legalMasks.begin() + index * (side * side + 1));
+
+    }
+
+    /**
+     *
+     * takes back every move of a game, which is much cheaper than making a new game
+     *
+     * @param index index of the game
+     */
+    void GoEnvBatch::restart(unsigned index){
+        games[index].endPlayout();
+        games[index].startPlayout();
+        moveCounts[index] = 0;
+    }
+
+    /**
+     *
+     * plays an action in one of the games
+     *
+     * @param index index of the game
+     * @param action legal action to play
+     */
+    void GoEnvBatch::stepGame(unsigned index, int64_t action){
+
+        GoGame& game = games[index];
+        Stone player = game.getActivePlayer();
+
+        MoveStatus status = action == side * side ? game.tryPlay(Move::pass(player)) :
+                            game.tryPlay(Move(unsigned(action / side), unsigned(action % side), player));
+
+        if (status != LEGAL){
+            // step checks the actions against the legal move masks, so this means a mask is out of date
+            throw std::domain_error("action " + std::to_string(action) + " of game " + std::to_string(index) +
+                                    " is illegal");
+        }
+
+        moveCounts[index]++;
+
+        rewards[index] = 0;
+        done[index] = 0;
+
+        if (game.getPassCount() >= 2 or moveCounts[index] >= maxMoves){
+            rewards[index] = float(getResultValue(game, player));
+            done[index] = 1;
+            restart(index);
+        }
+
+        observe(index);
+    }
+
+}
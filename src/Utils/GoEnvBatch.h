@@ -0,0 +1,64 @@
+#ifndef SENTE_GOENVBATCH_H
+#define SENTE_GOENVBATCH_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "../Game/GoGame.h"
+
+namespace sente::utils {
+
+    /**
+     *
+     * steps many games in lockstep for reinforcement learning. Every step plays one action in each game (the point
+     * x * side + y, or side * side to pass) and refreshes the observations, legal move masks, rewards and done flags,
+     * which are kept in buffers that are reused from step to step. Games that finish are started over straight away
+     *
+     */
+    class GoEnvBatch {
+    public:
+
+        GoEnvBatch(unsigned count, unsigned side, Rules rules, double komi, KoRule koRule,
+                   std::vector<std::string> features, unsigned maxMoves, unsigned threads);
+
+        void reset();
+        void step(const std::vector<int64_t>& actions);
+
+        [[nodiscard]] unsigned getCount() const;
+        [[nodiscard]] unsigned getSide() const;
+        [[nodiscard]] unsigned getFeatureCount() const;
+
+        [[nodiscard]] const GoGame& getGame(unsigned index) const;
+
+        [[nodiscard]] const std::vector<uint8_t>& getObservations() const;
+        [[nodiscard]] const std::vector<uint8_t>& getLegalMasks() const;
+        [[nodiscard]] const std::vector<float>& getRewards() const;
+        [[nodiscard]] const std::vector<uint8_t>& getDone() const;
+
+    private:
+
+        unsigned side;
+        std::vector<std::string> features;
+        unsigned planes; // number of planes the features take up
+        unsigned maxMoves;
+        unsigned threads;
+
+        // the games stay in a playout, so that starting over only takes back the moves
+        std::vector<GoGame> games;
+        std::vector<unsigned> moveCounts;
+
+        std::vector<uint8_t> observations; // (count, side, side, planes)
+        std::vector<uint8_t> legalMasks; // (count, side * side + 1)
+        std::vector<float> rewards; // for the player that made the last action
+        std::vector<uint8_t> done;
+
+        void observe(unsigned index);
+        void restart(unsigned index);
+        void stepGame(unsigned index, int64_t action);
+
+    };
+
+}
+
+#endif //SENTE_GOENVBATCH_H
@@ -3,9 +3,16 @@
 //
 
 #include <map>
+#include <array>
+#include <thread>
+#include <algorithm>
+#include <type_traits>
+#include <stdexcept>
 #include <ciso646>
 
 #include "Numpy.h"
+#include "Parallel.h"
+#include "../Game/Tactics.h"
 
 namespace sente::utils {
 
@@ -13,7 +20,52 @@ namespace sente::utils {
         BLACK_STONES,
         WHITE_STONES,
         EMPTY_POINTS,
-        KO_POINTS
+        KO_POINTS,
+        LEGAL_MOVES,
+        PLAYER_STONES,
+        OPPONENT_STONES,
+        SIDE_TO_MOVE,
+        SENSIBLENESS,
+        LADDER_CAPTURE,
+        LADDER_ESCAPE,
+        // the features below are counts split into BINNED_PLANES one-hot planes, the last plane holding every count
+        // past the others
+        LIBERTIES,
+        LIBERTIES_AFTER_MOVE,
+        CAPTURE_SIZE,
+        SELF_ATARI_SIZE,
+        TURNS_SINCE,
+        // the features below are a stone plane for each of the last HISTORY_PLANES positions, starting with the
+        // current one
+        HISTORY_BLACK,
+        HISTORY_WHITE,
+        HISTORY_PLAYER,
+        HISTORY_OPPONENT
+    };
+
+    constexpr unsigned BINNED_PLANES = 8;
+    constexpr unsigned HISTORY_PLANES = 8;
+
+    // clones made for a search have to remember enough moves for the binned and history features
+    static_assert(BINNED_PLANES - 1 <= CLONE_HISTORY and HISTORY_PLANES - 1 <= CLONE_HISTORY);
+
+    // types that features and boards can be written as
+    enum elementType {
+        UINT8,
+        INT8,
+        FLOAT16,
+        FLOAT32
+    };
+
+    /**
+     *
+     * a numpy float16, stored as its bits. Only 0, 1 and -1 are ever written, so there is no need for a full conversion
+     * from float
+     *
+     */
+    struct Half {
+        Half(int value) : bits(value == 0 ? 0x0000 : value > 0 ? 0x3C00 : 0xBC00) {}
+        uint16_t bits;
     };
 
     std::map<std::string, feature> featureMap {
@@ -21,167 +73,1043 @@ namespace sente::utils {
         {"White Stones", WHITE_STONES},
         {"Empty Points", EMPTY_POINTS},
         {"Ko Points", KO_POINTS},
+        {"Legal Moves", LEGAL_MOVES},
+        {"Player Stones", PLAYER_STONES},
+        {"Opponent Stones", OPPONENT_STONES},
+        {"Side To Move", SIDE_TO_MOVE},
+        {"Sensibleness", SENSIBLENESS},
+        {"Ladder Capture", LADDER_CAPTURE},
+        {"Ladder Escape", LADDER_ESCAPE},
+        {"Liberties", LIBERTIES},
+        {"Liberties After Move", LIBERTIES_AFTER_MOVE},
+        {"Capture Size", CAPTURE_SIZE},
+        {"Self Atari Size", SELF_ATARI_SIZE},
+        {"Turns Since", TURNS_SINCE},
+        {"Black History", HISTORY_BLACK},
+        {"White History", HISTORY_WHITE},
+        {"Player History", HISTORY_PLAYER},
+        {"Opponent History", HISTORY_OPPONENT},
         {"black_stones", BLACK_STONES},
         {"white_stones", WHITE_STONES},
         {"empty_points", EMPTY_POINTS},
-        {"ko_points", KO_POINTS}
+        {"ko_points", KO_POINTS},
+        {"legal_moves", LEGAL_MOVES},
+        {"player_stones", PLAYER_STONES},
+        {"opponent_stones", OPPONENT_STONES},
+        {"side_to_move", SIDE_TO_MOVE},
+        {"sensibleness", SENSIBLENESS},
+        {"ladder_capture", LADDER_CAPTURE},
+        {"ladder_escape", LADDER_ESCAPE},
+        {"liberties", LIBERTIES},
+        {"liberties_after_move", LIBERTIES_AFTER_MOVE},
+        {"capture_size", CAPTURE_SIZE},
+        {"self_atari_size", SELF_ATARI_SIZE},
+        {"turns_since", TURNS_SINCE},
+        {"history_black", HISTORY_BLACK},
+        {"history_white", HISTORY_WHITE},
+        {"history_player", HISTORY_PLAYER},
+        {"history_opponent", HISTORY_OPPONENT}
     };
 
-    void getNextBlackStone(const GoGame& game, int8_t* buffer_ptr, unsigned bufferIndex, Vertex toCheck);
-    void getNextWhiteStone(const GoGame& game, int8_t* buffer_ptr, unsigned bufferIndex, Vertex VertextoCheck);
-    void getNextEmptySpace(const GoGame& game, int8_t* buffer_ptr, unsigned bufferIndex, Vertex toCheck);
-    void getNextKoPoint(const GoGame& game, int8_t* buffer_ptr, unsigned bufferIndex, Vertex toCheck);
+    /**
+     *
+     * @param item feature to count the planes of
+     * @return the number of planes the feature takes up
+     */
+    unsigned countPlanes(feature item){
+        if (item >= HISTORY_BLACK){
+            return HISTORY_PLANES;
+        }
+        return item >= LIBERTIES ? BINNED_PLANES : 1;
+    }
 
     /**
      *
-     * Generate a features matrix for a given go game
+     * @param item feature to check
+     * @return whether the feature is only filled in on the points the active player can legally play on
+     */
+    bool usesLegalPoints(feature item){
+        switch (item){
+            case LEGAL_MOVES:
+            case SENSIBLENESS:
+            case LADDER_CAPTURE:
+            case LADDER_ESCAPE:
+            case LIBERTIES_AFTER_MOVE:
+            case CAPTURE_SIZE:
+            case SELF_ATARI_SIZE:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    unsigned countPlanes(const std::vector<feature>& features){
+        unsigned planes = 0;
+        for (auto item : features){
+            planes += countPlanes(item);
+        }
+        return planes;
+    }
+
+    /**
      *
-     * @param game the game to generate the features vector for
-     * @param features list of features to Include in the game
-     * @return a numpy array containing desired features
+     * makes sure that every game of a batch exists and is played on the same board size, so that the features of
+     * each game take up the same number of points
+     *
+     * @param games games of the batch
+     */
+    void checkBoardSizes(const std::vector<GoGame*>& games){
+        for (unsigned index = 0; index < games.size(); index++){
+            if (games[index] == nullptr){
+                throw std::domain_error("game " + std::to_string(index) + " is None");
+            }
+            if (games[index]->getSide() != games[0]->getSide()){
+                throw std::domain_error("game " + std::to_string(index) + " is played on a " +
+                                        std::to_string(games[index]->getSide()) + "x" +
+                                        std::to_string(games[index]->getSide()) + " board, but game 0 is played on a " +
+                                        std::to_string(games[0]->getSide()) + "x" +
+                                        std::to_string(games[0]->getSide()) + " board");
+            }
+        }
+    }
+
+    /**
+     *
+     * obtains the set of points that make up a single plane feature
+     *
+     * @param state position to get the feature from
+     * @param ko the ko point of the game
+     * @param legal points the active player can legally play on
+     * @param player the active player
+     * @param item feature to get
+     * @return set of points where the feature is present
      */
-    py::array_t<uint8_t> getFeatures(const GoGame& game, const std::vector<feature>& features){
+    template<unsigned side>
+    Bitboard<side> getFeaturePlane(const GameState<side>& state, Vertex ko, const PointSet& legal, Stone player,
+                                   feature item){
+
+        const GroupTable& groups = state.getGroups();
+
+        // the move features only apply to the points the active player can play on
+        auto legalMoves = [&](auto test){
+            Bitboard<side> plane;
+            legal.forEach([&](Point point){
+                if (test(point)){
+                    plane.set(point);
+                }
+            });
+            return plane;
+        };
+
+        switch (item){
+            case LEGAL_MOVES:
+                return legalMoves([](Point){
+                    return true;
+                });
+            case SENSIBLENESS:
+                return legalMoves([&](Point point){
+                    return not isEye(groups, point, player);
+                });
+            case LADDER_CAPTURE:
+                return legalMoves([&](Point point){
+                    return isLadderCapture(groups, point, player);
+                });
+            case LADDER_ESCAPE:
+                return legalMoves([&](Point point){
+                    return isLadderEscape(groups, point, player);
+                });
+            case BLACK_STONES:
+                return state.getBoard().getStones(BLACK);
+            case WHITE_STONES:
+                return state.getBoard().getStones(WHITE);
+            case PLAYER_STONES:
+                return state.getBoard().getStones(player);
+            case OPPONENT_STONES:
+                return state.getBoard().getStones(getOpponent(player));
+            case EMPTY_POINTS:
+                return state.getBoard().getEmptyPoints();
+            case SIDE_TO_MOVE:
+                return player == BLACK ? Bitboard<side>::full() : Bitboard<side>();
+            case KO_POINTS:
+            default:
+                if (ko.getX() < side and ko.getY() < side){
+                    return Bitboard<side>::fromIndex(Bitboard<side>::toIndex(ko.getX(), ko.getY()));
+                }
+                return {};
+        }
+    }
+
+    /**
+     *
+     * obtains the count that a binned feature splits into planes for every point of the board
+     *
+     * @param game game to get the feature from
+     * @param groups chains of stones on the board
+     * @param legal points the active player can legally play on
+     * @param outcomes outcome of a move on each legal point, filled in by the first feature that needs them
+     * @param item feature to get
+     * @return the count for each point, or -1 where the feature does not apply
+     */
+    std::vector<int> getFeatureCounts(const GoGame& game, const GroupTable& groups, const PointSet& legal,
+                                      std::vector<MoveOutcome>& outcomes, feature item){
 
         unsigned side = game.getSide();
+        Stone player = game.getActivePlayer();
+
+        std::vector<int> counts(side * side, -1);
+
+        if (item == LIBERTIES){
+            for (unsigned index = 0; index < side * side; index++){
+                if (groups.getStone(index) != EMPTY){
+                    counts[index] = int(groups.countLiberties(index));
+                }
+            }
+            return counts;
+        }
+
+        if (item == TURNS_SINCE){
+            auto moves = game.getRecentMoves(BINNED_PLANES - 1);
+
+            // stones that were not played in the last few moves count as played long ago
+            for (unsigned index = 0; index < side * side; index++){
+                if (groups.getStone(index) != EMPTY){
+                    counts[index] = BINNED_PLANES;
+                }
+            }
 
-        auto result = py::array_t<int8_t>(long(side * side * features.size()));
-        auto buffer = result.request(true);
-
-        auto* buffer_ptr = (int8_t*) buffer.ptr;
-
-        for (unsigned i = 0; i < side; i++){
-            for (unsigned j = 0; j < side; j++){
-
-                unsigned featureOffset = 0;
-                unsigned boardOffset = (side * i + j) * features.size();
-
-                for (const auto& item : features){
-                    switch (item){
-                        case BLACK_STONES:
-                            getNextBlackStone(game, buffer_ptr, boardOffset + featureOffset, {i, j});
-                            break;
-                        case WHITE_STONES:
-                            getNextWhiteStone(game, buffer_ptr, boardOffset + featureOffset, {i, j});
-                            break;
-                        case EMPTY_POINTS:
-                            getNextEmptySpace(game, buffer_ptr, boardOffset + featureOffset, {i, j});
-                            break;
-                        case KO_POINTS:
-                            getNextKoPoint(game, buffer_ptr, boardOffset + featureOffset, {i, j});
-                            break;
+            // go from the oldest move to the newest, so that a point played on twice ends up with its latest move
+            for (unsigned age = moves.size(); age-- > 0;){
+                const Move& move = moves[age];
+                if (not move.isPass() and move.getX() < side and move.getY() < side){
+                    unsigned index = groups.toIndex(move.getX(), move.getY());
+                    if (groups.getStone(index) == move.getStone()){
+                        counts[index] = int(age + 1);
                     }
-                    featureOffset++;
                 }
+            }
+            return counts;
+        }
+
+        if (outcomes.empty()){
+            outcomes.resize(side * side);
+            legal.forEach([&](Point point){
+                outcomes[point] = getMoveOutcome(groups, point, player);
+            });
+        }
 
+        legal.forEach([&](Point point){
+            const MoveOutcome& outcome = outcomes[point];
+            switch (item){
+                case LIBERTIES_AFTER_MOVE:
+                    counts[point] = int(outcome.liberties);
+                    break;
+                case CAPTURE_SIZE:
+                    counts[point] = int(outcome.captured);
+                    break;
+                case SELF_ATARI_SIZE:
+                default:
+                    if (outcome.liberties == 1){
+                        counts[point] = int(outcome.chainSize);
+                    }
+                    break;
             }
+        });
+
+        return counts;
+    }
+
+    /**
+     *
+     * writes the features of a game into a buffer, without touching any python objects
+     *
+     * @tparam T type of the elements of the buffer
+     * @param game the game to generate the features for
+     * @param features list of features to include
+     * @param output buffer with room for side * side * countPlanes(features) entries, filled in the order
+     * (x, y, plane), or (plane, x, y) if the channels come first
+     * @param symmetry symmetry of the board to write the features in (see transformVertex)
+     * @param channelsFirst whether to put the planes before the points
+     */
+    template<typename T>
+    void writeFeatures(const GoGame& game, const std::vector<feature>& features, T* output, unsigned symmetry,
+                       bool channelsFirst){
+
+        unsigned side = game.getSide();
+        unsigned depth = countPlanes(features);
+
+        // distance between neighboring points and neighboring planes in the output
+        unsigned pointStride = channelsFirst ? 1 : depth;
+        unsigned planeStride = channelsFirst ? side * side : 1;
+
+        // where the first plane of each point is written, which puts the planes straight into the symmetry
+        std::vector<unsigned> rows(side * side);
+        for (unsigned index = 0; index < side * side; index++){
+            Vertex target = transformVertex({index / side, index % side}, symmetry, side);
+            rows[index] = (target.getX() * side + target.getY()) * pointStride;
         }
 
-        result.resize({side, side, unsigned(features.size())});
+        Vertex ko = game.getKoPoint();
+        Stone player = game.getActivePlayer();
 
-        return result;
+        game.visitState([&](const auto& state){
+
+            std::vector<MoveOutcome> outcomes;
+            std::vector<StoneSets> history;
+            bool historyFound = false;
+
+            // finding the legal points checks every empty point against the ko rule, so only do it if it is needed
+            PointSet legal;
+            bool legalFound = false;
+
+            unsigned planeOffset = 0;
+
+            for (auto item : features){
+
+                T* planes = output + planeOffset * planeStride;
+
+                if (not legalFound and usesLegalPoints(item)){
+                    legal = game.getLegalPoints();
+                    legalFound = true;
+                }
+
+                if (item >= HISTORY_BLACK){
+
+                    if (not historyFound){
+                        history = game.getRecentPositions(HISTORY_PLANES - 1);
+                        historyFound = true;
+                    }
+
+                    Stone color = item == HISTORY_BLACK or (item == HISTORY_PLAYER and player == BLACK) or
+                                  (item == HISTORY_OPPONENT and player == WHITE) ? BLACK : WHITE;
+
+                    auto current = state.getBoard().getStones(color);
+
+                    // positions from before the board was set up are left empty
+                    for (unsigned index = 0; index < side * side; index++){
+                        planes[rows[index]] = T(current.test(index));
+                        for (unsigned age = 1; age < HISTORY_PLANES; age++){
+                            planes[rows[index] + age * planeStride] = T(age <= history.size() and
+                                (color == BLACK ? history[age - 1].black : history[age - 1].white).contains(index));
+                        }
+                    }
+                }
+                else if (countPlanes(item) == 1){
+                    auto plane = getFeaturePlane(state, ko, legal, player, item);
+
+                    // points are stored in the same order as the bitboard (side * x + y)
+                    for (unsigned index = 0; index < side * side; index++){
+                        planes[rows[index]] = T(plane.test(index));
+                    }
+                }
+                else {
+                    auto counts = getFeatureCounts(game, state.getGroups(), legal, outcomes, item);
+
+                    // capture sizes start from zero, the other counts from one
+                    int first = item == CAPTURE_SIZE ? 0 : 1;
+
+                    for (unsigned index = 0; index < side * side; index++){
+                        for (unsigned bin = 0; bin < BINNED_PLANES; bin++){
+                            planes[rows[index] + bin * planeStride] = T(0);
+                        }
+                        if (counts[index] >= first){
+                            unsigned bin = std::min<unsigned>(counts[index] - first, BINNED_PLANES - 1);
+                            planes[rows[index] + bin * planeStride] = T(1);
+                        }
+                    }
+                }
+
+                planeOffset += countPlanes(item);
+            }
+        });
 
     }
 
     /**
      *
-     * insert the black stones into a numpy array
+     * calls a function with the data of an array cast to a pointer to its elements
      *
-     * @param game game to get the stones from
-     * @param buffer_ptr the pointer to the insertion buffer
-     * @param bufferIndex the index to insert the next point at
-     * @param toCheck the point to check
+     * @param type type of the elements of the array
+     * @param data data of the array
+     * @param function generic function that takes the pointer
      */
-    void getNextBlackStone(const GoGame& game, int8_t* buffer_ptr, unsigned bufferIndex, Vertex toCheck){
+    template<typename Function>
+    void visitElements(elementType type, void* data, Function function){
+        switch (type){
+            case UINT8:
+                function(static_cast<uint8_t*>(data));
+                break;
+            case INT8:
+                function(static_cast<int8_t*>(data));
+                break;
+            case FLOAT16:
+                function(static_cast<Half*>(data));
+                break;
+            case FLOAT32:
+            default:
+                function(static_cast<float*>(data));
+                break;
+        }
+    }
 
-        // get the stone from the board
-        auto stone = game.getSpace(toCheck);
+    /**
+     *
+     * works out the type of the elements of a numpy dtype
+     *
+     * @param dtype dtype to look up
+     * @return the type of the elements
+     */
+    elementType getElementType(const py::dtype& dtype){
 
-        if (stone == BLACK){
-            buffer_ptr[bufferIndex] = 1;
+        if (dtype.kind() == 'u' and dtype.itemsize() == 1){
+            return UINT8;
         }
-        else {
-            buffer_ptr[bufferIndex] = 0;
+        if (dtype.kind() == 'i' and dtype.itemsize() == 1){
+            return INT8;
+        }
+        if (dtype.kind() == 'f' and dtype.itemsize() == 2){
+            return FLOAT16;
+        }
+        if (dtype.kind() == 'f' and dtype.itemsize() == 4){
+            return FLOAT32;
         }
 
+        throw std::domain_error("arrays can only be written as uint8, int8, float16 or float32");
+
     }
 
     /**
      *
-     * insert the white stones into a numpy array
+     * finds the array to write into, either the array passed by the caller, which is checked to have the right shape,
+     * or a new array
      *
-     * @param game game to get the stones from
-     * @param buffer_ptr the pointer to the insertion buffer
-     * @param bufferIndex the index to insert the next point at
-     * @param toCheck the point to check
+     * @param out array to fill, or None to allocate a new one
+     * @param dtype dtype of the array, or None for the dtype of out (or uint8 if out is None as well)
+     * @param shape shape that the array must have
+     * @param type filled with the type of the elements of the array
+     * @return the array to write into
      */
-    void getNextWhiteStone(const GoGame& game, int8_t* buffer_ptr, unsigned bufferIndex, Vertex toCheck){
+    py::array getOutput(const py::object& out, const py::object& dtype, const std::vector<long>& shape,
+                        elementType& type){
+
+        if (out.is_none()){
+            py::dtype outputType = dtype.is_none() ? py::dtype::of<uint8_t>() : py::dtype::from_args(dtype);
+            type = getElementType(outputType);
+            return py::array(outputType, shape);
+        }
+
+        if (not py::isinstance<py::array>(out)){
+            throw std::domain_error("out must be a numpy array");
+        }
+        auto output = out.cast<py::array>();
 
-        // get the stone from the board
-        auto stone = game.getSpace(toCheck);
+        type = getElementType(output.dtype());
 
-        if (stone == WHITE){
-            buffer_ptr[bufferIndex] = 1;
+        // the values are written straight into the array, so it can't be converted to another type or layout
+        if (not dtype.is_none() and getElementType(py::dtype::from_args(dtype)) != type){
+            throw std::domain_error("out does not have the requested dtype");
         }
-        else {
-            buffer_ptr[bufferIndex] = 0;
+        if (not (output.flags() & py::array::c_style) or not output.writeable()){
+            throw std::domain_error("out must be a writeable, C contiguous array");
+        }
+
+        if (size_t(output.ndim()) != shape.size() or not std::equal(shape.begin(), shape.end(), output.shape())){
+            std::string expected;
+            for (unsigned i = 0; i < shape.size(); i++){
+                expected += (i == 0 ? "" : ", ") + std::to_string(shape[i]);
+            }
+            throw std::domain_error("out must have the shape (" + expected + ")");
+        }
+
+        return output;
+
+    }
+
+    /**
+     *
+     * @param side side length of the board
+     * @return the number of bytes that a plane takes up when its points are packed into bits
+     */
+    long packedSize(unsigned side){
+        return (side * side + 7) / 8;
+    }
+
+    /**
+     *
+     * packs planes of 0s and 1s into bits, in the same order as numpy.packbits: the first point of a plane goes in
+     * the highest bit of its first byte, and the last byte of each plane is padded with zeros
+     *
+     * @param planes planes to pack, one after another
+     * @param count number of planes
+     * @param side side length of the board
+     * @param output buffer with room for count * packedSize(side) bytes
+     */
+    void packBits(const uint8_t* planes, unsigned count, unsigned side, uint8_t* output){
+
+        unsigned points = side * side;
+
+        for (unsigned plane = 0; plane < count; plane++){
+            const uint8_t* input = planes + plane * points;
+            uint8_t* bytes = output + plane * packedSize(side);
+
+            for (unsigned byte = 0; byte < packedSize(side); byte++){
+                uint8_t packed = 0;
+                for (unsigned bit = 0; bit < 8 and byte * 8 + bit < points; bit++){
+                    packed |= uint8_t(input[byte * 8 + bit] != 0) << (7 - bit);
+                }
+                bytes[byte] = packed;
+            }
+        }
+
+    }
+
+    /**
+     *
+     * unpacks planes packed by packBits
+     *
+     * @tparam T type of the elements of the output
+     * @param packed packed planes, packedSize(side) bytes each
+     * @param count number of planes
+     * @param side side length of the board
+     * @param output buffer with room for count * side * side elements, filled in the order (plane, x, y), or
+     * (x, y, plane) if the channels come last
+     * @param channelsFirst whether to put the planes before the points
+     */
+    template<typename T>
+    void unpackBits(const uint8_t* packed, unsigned count, unsigned side, T* output, bool channelsFirst){
+
+        unsigned points = side * side;
+
+        unsigned pointStride = channelsFirst ? 1 : count;
+        unsigned planeStride = channelsFirst ? points : 1;
+
+        // one entry for each bit pattern, so that a whole byte is unpacked at once
+        static const auto table = []{
+            std::array<std::array<uint8_t, 8>, 256> bits{};
+            for (unsigned byte = 0; byte < 256; byte++){
+                for (unsigned bit = 0; bit < 8; bit++){
+                    bits[byte][bit] = (byte >> (7 - bit)) & 1;
+                }
+            }
+            return bits;
+        }();
+
+        for (unsigned plane = 0; plane < count; plane++){
+            const uint8_t* bytes = packed + plane * packedSize(side);
+            T* values = output + plane * planeStride;
+
+            for (unsigned point = 0; point < points; point++){
+                values[point * pointStride] = T(table[bytes[point / 8]][point % 8]);
+            }
+        }
+
+    }
+
+    /**
+     *
+     * writes the features of a game packed into bits, with one row of packedSize(side) bytes for each plane
+     *
+     * @param game the game to generate the features for
+     * @param features list of features to include
+     * @param output buffer with room for countPlanes(features) * packedSize(side) bytes
+     * @param symmetry symmetry of the board to write the features in (see transformVertex)
+     */
+    void writePackedFeatures(const GoGame& game, const std::vector<feature>& features, uint8_t* output,
+                             unsigned symmetry){
+
+        unsigned side = game.getSide();
+        unsigned depth = countPlanes(features);
+
+        std::vector<uint8_t> planes(side * side * depth);
+        writeFeatures(game, features, planes.data(), symmetry, true);
+
+        packBits(planes.data(), depth, side, output);
+
+    }
+
+    /**
+     *
+     * checks that an array can hold packed bits, which are always stored as uint8
+     *
+     * @param dtype dtype requested by the caller, or None
+     */
+    void checkPackedType(const py::object& dtype){
+        if (not dtype.is_none() and getElementType(py::dtype::from_args(dtype)) != UINT8){
+            throw std::domain_error("packed arrays can only be written as uint8");
+        }
+    }
+
+    /**
+     *
+     * looks up the features with the given names
+     *
+     * @param features names of the features
+     * @return the features
+     */
+    std::vector<feature> toFeatures(const std::vector<std::string>& features){
+
+        auto featureVector = std::vector<feature>();
+
+        // this can run on several threads at once, so the map must not be modified
+        for (const auto& item : features){
+            auto entry = featureMap.find(item);
+            if (entry == featureMap.end()){
+                throw std::domain_error("unknown feature \"" + item + "\"");
+            }
+            featureVector.push_back(entry->second);
         }
+
+        return featureVector;
+
+    }
+
+    void writeFeatures(const GoGame& game, const std::vector<std::string>& features, uint8_t* output,
+                       unsigned symmetry, bool channelsFirst){
+        writeFeatures(game, toFeatures(features), output, symmetry, channelsFirst);
+    }
+
+    void writePackedFeatures(const GoGame& game, const std::vector<std::string>& features, uint8_t* output,
+                             unsigned symmetry){
+        writePackedFeatures(game, toFeatures(features), output, symmetry);
     }
 
     /**
-    *
-    * insert the empty spaces into a numpy array
-    *
-    * @param game game to get the stones from
-    * @param buffer_ptr the pointer to the insertion buffer
-    * @param bufferIndex the index to insert the next point at
-    * @param toCheck the point to check
-    */
-    void getNextEmptySpace(const GoGame& game, int8_t* buffer_ptr, unsigned bufferIndex, Vertex toCheck){
+     *
+     * counts the planes that a list of features takes up. Most features are a single plane, but counts (such as
+     * liberties) are split into several one-hot planes
+     *
+     * @param features names of the features
+     * @return the number of planes
+     */
+    unsigned countPlanes(const std::vector<std::string>& features){
+        return countPlanes(toFeatures(features));
+    }
 
-        // get the stone from the board
-        auto stone = game.getSpace(toCheck);
+    /**
+     *
+     * Generate a features matrix for a given go game
+     *
+     * @param game the game to generate the features vector for
+     * @param features list of features to Include in the game
+     * @param symmetry symmetry of the board to write the features in (see transformVertex)
+     * @param out array to fill, or None to allocate a new one
+     * @param dtype dtype of the array (uint8, int8, float16 or float32), or None for the dtype of out
+     * @param channelsFirst whether the planes come before the points, giving the shape (features, side, side) rather
+     * than (side, side, features)
+     * @param packed whether to pack the points of each plane into bits (see packBits), giving the uint8 array
+     * (features, packedSize(side))
+     * @return a numpy array containing desired features
+     */
+    py::array getFeatures(const GoGame& game, const std::vector<std::string>& features, unsigned symmetry,
+                          const py::object& out, const py::object& dtype, bool channelsFirst, bool packed){
+
+        auto featureVector = toFeatures(features);
+
+        long side = game.getSide();
+        long depth = countPlanes(featureVector);
+
+        elementType type;
+
+        if (packed){
+            checkPackedType(dtype);
+            py::array output = getOutput(out, py::dtype::of<uint8_t>(), {depth, packedSize(side)}, type);
+            writePackedFeatures(game, featureVector, static_cast<uint8_t*>(output.mutable_data()), symmetry);
+            return output;
+        }
+
+        py::array output = getOutput(out, dtype, channelsFirst ? std::vector<long>{depth, side, side} :
+                                                                 std::vector<long>{side, side, depth}, type);
+
+        visitElements(type, output.mutable_data(), [&](auto* data){
+            writeFeatures(game, featureVector, data, symmetry, channelsFirst);
+        });
+
+        return output;
+
+    }
+
+    /**
+     *
+     * generates the features of many games at once, filling one array with the games split between several threads
+     *
+     * @param games games to generate the features of, which must all be played on the same board size
+     * @param features list of features to include
+     * @param out array to fill, with the shape (games, side, side, features), or None to allocate a new one
+     * @param threads number of threads to fill the array with (0 uses one thread per core)
+     * @param symmetries symmetry to write each game in (see transformVertex), or empty to leave every game as it is
+     * @param dtype dtype of the array (uint8, int8, float16 or float32), or None for the dtype of out
+     * @param channelsFirst whether the planes come before the points, giving the shape (games, features, side, side)
+     * @param packed whether to pack the points of each plane into bits (see packBits), giving the uint8 array
+     * (games, features, packedSize(side))
+     * @return the filled array
+     */
+    py::array getBatchFeatures(const std::vector<GoGame*>& games, const std::vector<std::string>& features,
+                               const py::object& out, unsigned threads, const std::vector<unsigned>& symmetries,
+                               const py::object& dtype, bool channelsFirst, bool packed){
 
-        if (stone == EMPTY){
-            buffer_ptr[bufferIndex] = 1;
+        if (games.empty()){
+            throw std::domain_error("expected at least one game");
+        }
+
+        if (not symmetries.empty() and symmetries.size() != games.size()){
+            throw std::domain_error("expected a symmetry for each of the " + std::to_string(games.size()) +
+                                    " games, got " + std::to_string(symmetries.size()));
+        }
+
+        for (auto symmetry : symmetries){
+            invertSymmetry(symmetry); // throws if the symmetry doesn't exist
+        }
+
+        checkBoardSizes(games);
+
+        auto featureVector = toFeatures(features);
+
+        long count = games.size();
+        long side = games[0]->getSide();
+        long depth = countPlanes(featureVector);
+
+        if (packed){
+            checkPackedType(dtype);
+        }
+
+        elementType type;
+        py::array output;
+
+        if (packed){
+            output = getOutput(out, py::dtype::of<uint8_t>(), {count, depth, packedSize(side)}, type);
         }
         else {
-            buffer_ptr[bufferIndex] = 0;
+            output = getOutput(out, dtype, channelsFirst ? std::vector<long>{count, depth, side, side} :
+                                                           std::vector<long>{count, side, side, depth}, type);
+        }
+
+        void* data = output.mutable_data();
+
+        if (threads == 0){
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        // writing the features of a game is much cheaper than starting a thread, so give each thread a few games
+        threads = std::min<unsigned>(threads, (count + 15) / 16);
+
+        {
+            py::gil_scoped_release release;
+
+            if (packed){
+                parallelFor(count, threads, [&](unsigned index){
+                    writePackedFeatures(*games[index], featureVector,
+                                        static_cast<uint8_t*>(data) + index * depth * packedSize(side),
+                                        symmetries.empty() ? 0 : symmetries[index]);
+                });
+            }
+            else {
+                visitElements(type, data, [&](auto* elements){
+                    parallelFor(count, threads, [&](unsigned index){
+                        writeFeatures(*games[index], featureVector, elements + index * side * side * depth,
+                                      symmetries.empty() ? 0 : symmetries[index], channelsFirst);
+                    });
+                });
+            }
         }
 
+        return output;
+
     }
 
+    /**
+     *
+     * writes the stones of a board into an array, with 1 for black stones, -1 for white stones and 0 for empty points
+     *
+     * @param side side length of the board
+     * @param black points with black stones
+     * @param white points with white stones
+     * @param out array with the shape (side, side) to fill, or None to allocate a new one
+     * @param dtype dtype of the array (int8, float16 or float32), or None for the dtype of out
+     * @param packed whether to pack the black and white stones into bits (see packBits) instead, giving the uint8
+     * array (2, packedSize(side))
+     * @return array with the stone on each point
+     */
+    py::array getBoardArray(unsigned side, const PointSet& black, const PointSet& white, const py::object& out,
+                            const py::object& dtype, bool packed){
+
+        elementType type;
+
+        if (packed){
+            checkPackedType(dtype);
+            py::array output = getOutput(out, py::dtype::of<uint8_t>(), {2, packedSize(side)}, type);
+
+            std::vector<uint8_t> planes(2 * side * side);
+            for (unsigned index = 0; index < side * side; index++){
+                planes[index] = black.contains(index);
+                planes[side * side + index] = white.contains(index);
+            }
+
+            packBits(planes.data(), 2, side, static_cast<uint8_t*>(output.mutable_data()));
+            return output;
+        }
+
+        py::array output = getOutput(out, dtype.is_none() and out.is_none() ? py::dtype::of<int8_t>() : dtype,
+                                     {long(side), long(side)}, type);
+
+        if (type == UINT8){
+            throw std::domain_error("white stones are stored as -1, so a board can't be written as uint8");
+        }
+
+        visitElements(type, output.mutable_data(), [&](auto* data){
+            using T = std::remove_pointer_t<decltype(data)>;
+            for (unsigned index = 0; index < side * side; index++){
+                data[index] = T(black.contains(index) ? 1 : white.contains(index) ? -1 : 0);
+            }
+        });
+
+        return output;
+
+    }
 
     /**
      *
-     * insert the ko points into a numpy array
+     * unpacks features or boards that were packed into bits, which is much faster than numpy.unpackbits followed by a
+     * reshape, transpose and cast
      *
-     * @param game game to get the stones from
-     * @param buffer_ptr the pointer to the insertion buffer
-     * @param bufferIndex the index to insert the next point at
-     * @param toCheck the point to check
+     * @param packed uint8 array with the shape (..., planes, packedSize(side))
+     * @param side side length of the board
+     * @param out array to fill, or None to allocate a new one
+     * @param dtype dtype of the array (uint8, int8, float16 or float32), or None for the dtype of out
+     * @param channelsFirst whether the planes come before the points, giving the shape (..., planes, side, side)
+     * rather than (..., side, side, planes)
+     * @return the unpacked array
      */
-    void getNextKoPoint(const GoGame& game, int8_t* buffer_ptr, unsigned bufferIndex, Vertex toCheck){
+    py::array unpackFeatures(const py::array& packed, unsigned side, const py::object& out, const py::object& dtype,
+                             bool channelsFirst){
 
-        Vertex ko = game.getKoPoint();
+        if (side < MIN_BOARD_SIZE or side > MAX_BOARD_SIZE){
+            throw std::domain_error("boards can't have a side of " + std::to_string(side));
+        }
+        if (not packed.dtype().is(py::dtype::of<uint8_t>())){
+            throw std::domain_error("packed arrays must have the dtype uint8");
+        }
+        if (not (packed.flags() & py::array::c_style)){
+            throw std::domain_error("packed arrays must be C contiguous");
+        }
+        if (packed.ndim() < 2 or packed.shape(packed.ndim() - 1) != packedSize(side)){
+            throw std::domain_error("a packed array for a " + std::to_string(side) + "x" + std::to_string(side) +
+                                    " board must have the shape (..., planes, " + std::to_string(packedSize(side)) +
+                                    ")");
+        }
+
+        long planes = packed.shape(packed.ndim() - 2);
 
-        if (ko.getX() == toCheck.getX() and ko.getY() == toCheck.getY()){
-            buffer_ptr[bufferIndex] = 1;
+        std::vector<long> shape(packed.shape(), packed.shape() + packed.ndim() - 2);
+        long count = 1;
+        for (auto length : shape){
+            count *= length;
+        }
+
+        if (channelsFirst){
+            shape.insert(shape.end(), {planes, long(side), long(side)});
         }
         else {
-            buffer_ptr[bufferIndex] = 0;
+            shape.insert(shape.end(), {long(side), long(side), planes});
         }
 
+        elementType type;
+        py::array output = getOutput(out, dtype, shape, type);
+
+        const auto* input = static_cast<const uint8_t*>(packed.data());
+        void* data = output.mutable_data();
+
+        {
+            py::gil_scoped_release release;
+
+            visitElements(type, data, [&](auto* elements){
+                for (long index = 0; index < count; index++){
+                    unpackBits(input + index * planes * packedSize(side), planes, side,
+                               elements + index * planes * side * side, channelsFirst);
+                }
+            });
+        }
+
+        return output;
+
+    }
+
+    /**
+     *
+     * stops python from writing to an array that views memory owned by C++, so the state behind it can't be changed
+     * from outside
+     *
+     * @param array array to make read-only
+     * @return the same array
+     */
+    template<typename T>
+    py::array_t<T> readOnly(py::array_t<T> array){
+        array.attr("flags").attr("writeable") = false;
+        return array;
     }
 
-    py::array_t<uint8_t> getFeatures(const GoGame& game, const std::vector<std::string>& features) {
+    /**
+     *
+     * gets a read-only numpy view of the moves the active player can legally play, without copying
+     *
+     * @param game python object of the game to get the legal moves of
+     * @param symmetry symmetry of the board to put the mask in (see transformVertex). Any symmetry other than 0 makes
+     * a new array rather than a view
+     * @return boolean array with an entry for each point of the board (in the order x * side + y) and one for passing
+     */
+    py::array_t<bool> getLegalMask(const py::object& game, unsigned symmetry){
 
-        auto featureVector = std::vector<feature>();
+        const auto& mask = game.cast<GoGame&>().getLegalMask();
 
-        for (const auto& item : features){
-            featureVector.push_back(featureMap[item]);
+        if (symmetry == 0){
+            // the array keeps the game alive for as long as it views the mask
+            return readOnly(py::array_t<bool>({long(mask.size())}, {long(sizeof(bool))},
+                                              reinterpret_cast<const bool*>(mask.data()), game));
+        }
+
+        unsigned side = game.cast<const GoGame&>().getSide();
+
+        py::array_t<bool> result(long(mask.size()));
+        bool* data = result.mutable_data();
+
+        for (unsigned index = 0; index < side * side; index++){
+            Vertex target = transformVertex({index / side, index % side}, symmetry, side);
+            data[target.getX() * side + target.getY()] = mask[index];
+        }
+        data[side * side] = mask[side * side];
+
+        return result;
+
+    }
+
+    /**
+     *
+     * reads the next chunk of samples from a dataset into numpy arrays
+     *
+     * @param dataset dataset to read from
+     * @return dictionary with the arrays "features", "moves", "results" and "move_numbers"
+     */
+    py::dict getNextChunk(SGFDataset& dataset){
+
+        Samples chunk;
+        bool found;
+
+        {
+            py::gil_scoped_release release;
+            found = dataset.nextChunk(chunk);
+        }
+
+        if (not found){
+            throw py::stop_iteration();
+        }
+
+        long count = chunk.size();
+
+        py::array_t<uint8_t> features(dataset.getFeatureShape(count));
+        py::array_t<int64_t> moves(count);
+        py::array_t<float> results(count);
+        py::array_t<int32_t> moveNumbers(count);
+
+        std::copy(chunk.features.begin(), chunk.features.end(), features.mutable_data());
+        std::copy(chunk.moves.begin(), chunk.moves.end(), moves.mutable_data());
+        std::copy(chunk.results.begin(), chunk.results.end(), results.mutable_data());
+        std::copy(chunk.moveNumbers.begin(), chunk.moveNumbers.end(), moveNumbers.mutable_data());
+
+        py::dict samples;
+
+        samples["features"] = features;
+        samples["moves"] = moves;
+        samples["results"] = results;
+        samples["move_numbers"] = moveNumbers;
+
+        return samples;
+
+    }
+
+    /**
+     *
+     * @param dataset dataset to get the skipped files of
+     * @return list of (file, reason) tuples for the files that have been skipped so far
+     */
+    py::list getSkippedFiles(const SGFDataset& dataset){
+
+        py::list skipped;
+
+        for (const auto& [file, reason] : dataset.getSkipped()){
+            skipped.append(py::make_tuple(file, reason));
         }
 
-        return getFeatures(game, featureVector);
+        return skipped;
+
+    }
+
+    /**
+     *
+     * gets a read-only numpy view of the observations of a batch of games, without copying. The view is updated in
+     * place by every step
+     *
+     * @param env python object of the batch of games
+     * @return array with the shape (games, side, side, features)
+     */
+    py::array_t<uint8_t> getObservations(const py::object& env){
+
+        const auto& batch = env.cast<const GoEnvBatch&>();
+        long side = batch.getSide();
+
+        long depth = batch.getFeatureCount();
+
+        return readOnly(py::array_t<uint8_t>({long(batch.getCount()), side, side, depth},
+                                             {side * side * depth, side * depth, depth, 1L},
+                                             batch.getObservations().data(), env));
+
+    }
+
+    /**
+     *
+     * gets a read-only numpy view of the legal moves of every game in a batch, without copying. The masks are what
+     * step checks the actions against, so they must not be changed from python
+     *
+     * @param env python object of the batch of games
+     * @return boolean array with the shape (games, side * side + 1)
+     */
+    py::array_t<bool> getLegalMasks(const py::object& env){
+
+        const auto& batch = env.cast<const GoEnvBatch&>();
+        long side = batch.getSide();
+
+        return readOnly(py::array_t<bool>({long(batch.getCount()), side * side + 1},
+                                          {long((side * side + 1) * sizeof(bool)), long(sizeof(bool))},
+                                          reinterpret_cast<const bool*>(batch.getLegalMasks().data()), env));
+
+    }
+
+    /**
+     *
+     * gets a read-only numpy view of the rewards of the last step of a batch of games, without copying
+     *
+     * @param env python object of the batch of games
+     * @return array with the reward of each game for the player that made the last action
+     */
+    py::array_t<float> getRewards(const py::object& env){
+
+        const auto& batch = env.cast<const GoEnvBatch&>();
+
+        return readOnly(py::array_t<float>({long(batch.getCount())}, {long(sizeof(float))},
+                                           batch.getRewards().data(), env));
+
+    }
+
+    /**
+     *
+     * gets a read-only numpy view of which games of a batch ended on the last step, without copying
+     *
+     * @param env python object of the batch of games
+     * @return boolean array with an entry for each game
+     */
+    py::array_t<bool> getDone(const py::object& env){
+
+        const auto& batch = env.cast<const GoEnvBatch&>();
+
+        return readOnly(py::array_t<bool>({long(batch.getCount())}, {long(sizeof(bool))},
+                                          reinterpret_cast<const bool*>(batch.getDone().data()), env));
 
     }
 
@@ -10,10 +10,37 @@
 #include <pybind11/numpy.h>
 
 #include "../Game/GoGame.h"
+#include "GoEnvBatch.h"
+#include "SGFDataset.h"
 
 namespace sente::utils {
 
-    py::array_t<uint8_t> getFeatures(const GoGame& game, const std::vector<std::string>& features);
+    unsigned countPlanes(const std::vector<std::string>& features);
+    long packedSize(unsigned side);
+    void checkBoardSizes(const std::vector<GoGame*>& games);
+    void writeFeatures(const GoGame& game, const std::vector<std::string>& features, uint8_t* output,
+                       unsigned symmetry = 0, bool channelsFirst = false);
+    void writePackedFeatures(const GoGame& game, const std::vector<std::string>& features, uint8_t* output,
+                             unsigned symmetry = 0);
+    py::array getFeatures(const GoGame& game, const std::vector<std::string>& features, unsigned symmetry = 0,
+                          const py::object& out = py::none(), const py::object& dtype = py::none(),
+                          bool channelsFirst = false, bool packed = false);
+    py::array getBatchFeatures(const std::vector<GoGame*>& games, const std::vector<std::string>& features,
+                               const py::object& out, unsigned threads, const std::vector<unsigned>& symmetries = {},
+                               const py::object& dtype = py::none(), bool channelsFirst = false, bool packed = false);
+    py::array getBoardArray(unsigned side, const PointSet& black, const PointSet& white, const py::object& out,
+                            const py::object& dtype, bool packed);
+    py::array unpackFeatures(const py::array& packed, unsigned side, const py::object& out, const py::object& dtype,
+                             bool channelsFirst);
+    py::array_t<bool> getLegalMask(const py::object& game, unsigned symmetry = 0);
+
+    py::dict getNextChunk(SGFDataset& dataset);
+    py::list getSkippedFiles(const SGFDataset& dataset);
+
+    py::array_t<uint8_t> getObservations(const py::object& env);
+    py::array_t<bool> getLegalMasks(const py::object& env);
+    py::array_t<float> getRewards(const py::object& env);
+    py::array_t<bool> getDone(const py::object& env);
 
 }
 
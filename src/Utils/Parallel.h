@@ -0,0 +1,65 @@
+#ifndef SENTE_PARALLEL_H
+#define SENTE_PARALLEL_H
+
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <exception>
+
+namespace sente::utils {
+
+    /**
+     *
+     * calls a function on every index up to a count, splitting the indices into one contiguous block for each thread.
+     * An exception thrown on any of the threads is thrown again once every thread has finished
+     *
+     * @param count number of indices
+     * @param threads number of threads to use (0 uses one thread per core)
+     * @param function function to call on each index
+     */
+    template<typename Function>
+    void parallelFor(unsigned count, unsigned threads, Function function){
+
+        if (threads == 0){
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        unsigned workers = std::min(threads, count);
+
+        if (workers <= 1){
+            for (unsigned index = 0; index < count; index++){
+                function(index);
+            }
+            return;
+        }
+
+        std::vector<std::exception_ptr> errors(workers);
+        std::vector<std::thread> pool;
+
+        for (unsigned worker = 0; worker < workers; worker++){
+            pool.emplace_back([&, worker](){
+                try {
+                    for (unsigned index = worker * count / workers; index < (worker + 1) * count / workers; index++){
+                        function(index);
+                    }
+                }
+                catch (...){
+                    errors[worker] = std::current_exception();
+                }
+            });
+        }
+
+        for (auto& thread : pool){
+            thread.join();
+        }
+
+        for (const auto& error : errors){
+            if (error){
+                std::rethrow_exception(error);
+            }
+        }
+    }
+
+}
+
+#endif //SENTE_PARALLEL_H
@@ -0,0 +1,80 @@
+#include <algorithm>
+
+#include "Numpy.h"
+#include "PythonEvaluator.h"
+
+namespace sente::utils {
+
+    /**
+     *
+     * @param function function that takes an array of features with the shape (batch, side, side, planes) and
+     * returns a tuple of the policy, with the shape (batch, side * side + 1), and the value of each position
+     * @param features names of the features to pass to the function (see getFeatures)
+     */
+    PythonEvaluator::PythonEvaluator(py::function function, std::vector<std::string> features)
+        : function(std::move(function)), features(std::move(features)) {}
+
+    /**
+     *
+     * reads the policy and the values of a batch of positions from the response of a python evaluator
+     *
+     * @param response tuple of the policy, with the shape (batch, side * side + 1), and the value of each position
+     * @param batch number of positions in the batch
+     * @param side side length of the board
+     * @return the policy and value of each position
+     */
+    std::vector<Evaluation> readEvaluations(const py::object& response, long batch, long side){
+
+        if (not py::isinstance<py::tuple>(response) or py::len(response) != 2){
+            throw std::domain_error("evaluator must return a tuple of the policy and the value");
+        }
+
+        auto policy = py::array_t<float, py::array::c_style | py::array::forcecast>::ensure(py::tuple(response)[0]);
+        auto value = py::array_t<float, py::array::c_style | py::array::forcecast>::ensure(py::tuple(response)[1]);
+
+        if (not policy or policy.ndim() != 2 or policy.shape(0) != batch or policy.shape(1) != side * side + 1){
+            throw std::domain_error("evaluator must return a policy with the shape (" + std::to_string(batch) + ", " +
+                                    std::to_string(side * side + 1) + ")");
+        }
+        if (not value or value.size() != batch){
+            throw std::domain_error("evaluator must return " + std::to_string(batch) + " values");
+        }
+
+        std::vector<Evaluation> evaluations(batch);
+
+        for (long i = 0; i < batch; i++){
+            const float* row = policy.data() + i * (side * side + 1);
+            evaluations[i].policy.assign(row, row + side * side + 1);
+            evaluations[i].value = std::clamp(double(value.data()[i]), -1.0, 1.0);
+        }
+
+        return evaluations;
+    }
+
+    /**
+     *
+     * evaluates a batch of positions with a single call to the python function. Search threads do not hold the GIL,
+     * so it is taken for the duration of the call
+     *
+     * @param games games at the positions to evaluate
+     * @return the policy and value of each position
+     */
+    std::vector<Evaluation> PythonEvaluator::evaluate(const std::vector<GoGame*>& games){
+
+        py::gil_scoped_acquire acquire;
+
+        long batch = long(games.size());
+        long side = long(games.front()->getSide());
+        long depth = long(countPlanes(features));
+
+        py::array_t<uint8_t> input({batch, side, side, depth});
+        uint8_t* inputPtr = input.mutable_data();
+
+        for (long i = 0; i < batch; i++){
+            writeFeatures(*games[i], features, inputPtr + i * side * side * depth);
+        }
+
+        return readEvaluations(function(input), batch, side);
+    }
+
+}
@@ -0,0 +1,37 @@
+#ifndef SENTE_PYTHONEVALUATOR_H
+#define SENTE_PYTHONEVALUATOR_H
+
+#include <string>
+#include <vector>
+
+#include <pybind11/numpy.h>
+
+#include "../Game/MCTS.h"
+
+namespace sente::utils {
+
+    std::vector<Evaluation> readEvaluations(const py::object& response, long batch, long side);
+
+    /**
+     *
+     * evaluates the leaves of a search with a python function (such as a neural network). The function is called
+     * with the features of a whole batch of positions at once
+     *
+     */
+    class PythonEvaluator : public Evaluator {
+    public:
+
+        PythonEvaluator(py::function function, std::vector<std::string> features);
+
+        std::vector<Evaluation> evaluate(const std::vector<GoGame*>& games) override;
+
+    private:
+
+        py::function function;
+        std::vector<std::string> features;
+
+    };
+
+}
+
+#endif //SENTE_PYTHONEVALUATOR_H
@@ -231,6 +231,12 @@ namespace sente::SGF {
                 }
             }
             else {
+                // older file formats record passes on boards up to 19x19 as "tt"
+                unsigned side = SGFTree.getRoot().hasProperty(SZ) ? std::stoi(SGFTree.getRoot().getProperty(SZ)[0]) : 19;
+                Move move = tempNode.getMove();
+                if (side <= 19 and move.getX() == 19 and move.getY() == 19){
+                    tempNode.setMove(Move::pass(move.getStone()));
+                }
                 SGFTree.insert(tempNode);
             }
             // validate the result with the file format version
@@ -135,10 +135,18 @@ namespace sente::SGF {
         return move;
     }
 
+    void SGFNode::setMove(const Move& move) {
+        this->move = move;
+    }
+
     std::unordered_set<Move> SGFNode::getAddedMoves() const {
         return addedMoves;
     }
 
+    void SGFNode::setAddedMoves(const std::unordered_set<Move>& moves) {
+        addedMoves = moves;
+    }
+
     void SGFNode::appendProperty(SGFProperty property, const std::string &value) {
 
         if (property == B or property == W){
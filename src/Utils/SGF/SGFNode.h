@@ -18,7 +18,9 @@ namespace sente::SGF {
         explicit SGFNode(const std::vector<std::string>& addedMoves);
 
         Move getMove() const;
+        void setMove(const Move& move);
         std::unordered_set<Move> getAddedMoves() const;
+        void setAddedMoves(const std::unordered_set<Move>& moves);
 
         void setProperty(SGFProperty property, const std::vector<std::string>& value);
         void appendProperty(SGFProperty property, const std::string& value);
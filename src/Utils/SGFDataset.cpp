@@ -0,0 +1,392 @@
+#include <thread>
+#include <fstream>
+#include <iterator>
+#include <algorithm>
+#include <filesystem>
+#include <stdexcept>
+
+#include "Numpy.h"
+#include "Parallel.h"
+#include "SGFDataset.h"
+#include "SGF/SGF.h"
+#include "SenteExceptions.h"
+#include "../Game/Zobrist.h"
+
+namespace sente::utils {
+
+    unsigned Samples::size() const {
+        return moves.size();
+    }
+
+    /**
+     *
+     * adds some of the samples of another set to the end of this one
+     *
+     * @param other samples to copy from
+     * @param begin first sample to copy
+     * @param end sample after the last one to copy
+     * @param sampleSize number of bytes of features in each sample
+     */
+    void Samples::append(const Samples& other, unsigned begin, unsigned end, unsigned sampleSize){
+        features.insert(features.end(), other.features.begin() + begin * sampleSize,
+                        other.features.begin() + end * sampleSize);
+        moves.insert(moves.end(), other.moves.begin() + begin, other.moves.begin() + end);
+        results.insert(results.end(), other.results.begin() + begin, other.results.begin() + end);
+        moveNumbers.insert(moveNumbers.end(), other.moveNumbers.begin() + begin, other.moveNumbers.begin() + end);
+    }
+
+    void Samples::clear(){
+        features.clear();
+        moves.clear();
+        results.clear();
+        moveNumbers.clear();
+    }
+
+    /**
+     *
+     * finds the SGF files to read, looking through directories (and the directories inside them) for files that end in
+     * ".sgf"
+     *
+     * @param paths files and directories to look in
+     * @return the files, with the files of each directory in sorted order so that the samples are always the same
+     */
+    std::vector<std::string> findSGFFiles(const std::vector<std::string>& paths){
+
+        std::vector<std::string> files;
+
+        for (const auto& path : paths){
+
+            if (std::filesystem::is_directory(path)){
+
+                std::vector<std::string> found;
+
+                for (const auto& entry : std::filesystem::recursive_directory_iterator(path)){
+                    std::string extension = entry.path().extension().string();
+                    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+                    if (entry.is_regular_file() and extension == ".sgf"){
+                        found.push_back(entry.path().string());
+                    }
+                }
+
+                std::sort(found.begin(), found.end());
+                files.insert(files.end(), found.begin(), found.end());
+            }
+            else if (std::filesystem::exists(path)){
+                files.push_back(path);
+            }
+            else {
+                throw FileNotFoundException(path);
+            }
+        }
+
+        return files;
+
+    }
+
+    /**
+     *
+     * @param paths SGF files and directories of SGF files to read
+     * @param features names of the features to take from each position (see getFeatures)
+     * @param side side length of the boards to keep, games played on other boards are skipped
+     * @param chunkSize number of samples in each chunk
+     * @param threads number of threads to read the files on (0 uses one thread per core)
+     * @param packed whether to pack the points of each plane into bits (see packBits)
+     * @param channelsFirst whether to put the planes of the features before the points
+     * @param augment whether to give each position a random rotation or reflection of the board
+     * @param seed seed for picking the symmetries, the same seed always gives the same symmetries
+     */
+    SGFDataset::SGFDataset(const std::vector<std::string>& paths, std::vector<std::string> features, unsigned side,
+                           unsigned chunkSize, unsigned threads, bool packed, bool channelsFirst, bool augment,
+                           uint64_t seed)
+        : files(findSGFFiles(paths)), features(std::move(features)), side(side), planes(countPlanes(this->features)),
+          chunkSize(chunkSize), threads(threads == 0 ? std::max(1u, std::thread::hardware_concurrency()) : threads),
+          packed(packed), channelsFirst(channelsFirst), augment(augment), seed(seed), nextFile(0), pendingStart(0){
+
+        if (side < MIN_BOARD_SIZE or side > MAX_BOARD_SIZE){
+            throw std::domain_error("boards can't have a side of " + std::to_string(side));
+        }
+        if (chunkSize == 0){
+            throw std::domain_error("chunks must have at least one sample");
+        }
+
+    }
+
+    /**
+     *
+     * starts over from the first file
+     *
+     */
+    void SGFDataset::reset(){
+        nextFile = 0;
+        pending.clear();
+        pendingStart = 0;
+        skipped.clear();
+    }
+
+    /**
+     *
+     * reads the next chunk of samples. Every chunk is full except for the last one
+     *
+     * @param chunk filled with the samples
+     * @return whether there were any samples left to read
+     */
+    bool SGFDataset::nextChunk(Samples& chunk){
+
+        unsigned sampleSize = getSampleSize();
+
+        // read a few files for each thread at a time, so that the threads have enough work to share
+        while (pending.size() - pendingStart < chunkSize and nextFile < files.size()){
+
+            unsigned count = std::min<unsigned>(4 * threads, files.size() - nextFile);
+            std::vector<Samples> games(count);
+            std::vector<std::string> errors(count);
+
+            parallelFor(count, threads, [&](unsigned index){
+                try {
+                    readGame(nextFile + index, games[index]);
+                }
+                catch (const IllegalMoveException&){
+                    games[index].clear();
+                    errors[index] = "the main line of the game has an illegal move";
+                }
+                catch (const std::exception& exception){
+                    games[index].clear();
+                    errors[index] = exception.what();
+                }
+            });
+
+            // drop the samples that have already been handed out before adding more
+            Samples remaining;
+            remaining.append(pending, pendingStart, pending.size(), sampleSize);
+            pending = std::move(remaining);
+            pendingStart = 0;
+
+            for (unsigned index = 0; index < count; index++){
+                if (not errors[index].empty()){
+                    skipped.emplace_back(files[nextFile + index], errors[index]);
+                }
+                pending.append(games[index], 0, games[index].size(), sampleSize);
+            }
+
+            nextFile += count;
+        }
+
+        unsigned size = std::min(chunkSize, pending.size() - pendingStart);
+
+        chunk.clear();
+        chunk.append(pending, pendingStart, pendingStart + size, sampleSize);
+        pendingStart += size;
+
+        return size > 0;
+
+    }
+
+    /**
+     *
+     * writes a single array to a .npy file
+     *
+     * @param path path of the file to write
+     * @param type numpy type string of the elements, without the byte order
+     * @param shape shape of the array
+     * @param data elements of the array
+     * @param bytes size of the array in bytes
+     */
+    void writeNpy(const std::string& path, const std::string& type, const std::vector<long>& shape, const void* data,
+                  size_t bytes){
+
+        uint16_t probe = 1;
+        char order = type == "u1" ? '|' : *reinterpret_cast<uint8_t*>(&probe) == 1 ? '<' : '>';
+
+        std::string dimensions;
+        for (auto length : shape){
+            dimensions += std::to_string(length) + ", ";
+        }
+        if (shape.size() > 1){
+            dimensions.erase(dimensions.size() - 2);
+        }
+        else {
+            dimensions.pop_back();
+        }
+
+        std::string header = "{'descr': '" + std::string(1, order) + type + "', 'fortran_order': False, 'shape': (" +
+                             dimensions + "), }";
+
+        // the magic string, version, length and header are padded with spaces to a multiple of 64 bytes
+        header.append((64 - (10 + header.size() + 1) % 64) % 64, ' ');
+        header += '\n';
+
+        std::ofstream output(path, std::ios::binary);
+        if (not output.good()){
+            throw std::domain_error("could not write to \"" + path + "\"");
+        }
+
+        uint16_t length = header.size();
+        output.write("\x93NUMPY\x01\x00", 8);
+        output.put(char(length & 0xFF));
+        output.put(char(length >> 8));
+        output << header;
+        output.write(static_cast<const char*>(data), std::streamsize(bytes));
+
+        if (not output.good()){
+            throw std::domain_error("could not write to \"" + path + "\"");
+        }
+
+    }
+
+    /**
+     *
+     * reads every file from the start and saves each chunk to a set of .npy files, named
+     * <prefix>_<chunk>_features.npy, <prefix>_<chunk>_moves.npy, <prefix>_<chunk>_results.npy and
+     * <prefix>_<chunk>_move_numbers.npy
+     *
+     * @param directory directory to put the files in, which is made if it doesn't exist
+     * @param prefix start of the name of each file
+     * @return the number of chunks written
+     */
+    unsigned SGFDataset::writeShards(const std::string& directory, const std::string& prefix){
+
+        std::filesystem::create_directories(directory);
+
+        reset();
+
+        Samples chunk;
+        unsigned shards = 0;
+
+        while (nextChunk(chunk)){
+
+            std::string number = std::to_string(shards);
+            number.insert(0, number.size() < 5 ? 5 - number.size() : 0, '0');
+
+            auto path = [&](const std::string& name){
+                return (std::filesystem::path(directory) / (prefix + "_" + number + "_" + name + ".npy")).string();
+            };
+
+            long count = chunk.size();
+
+            writeNpy(path("features"), "u1", getFeatureShape(count), chunk.features.data(), chunk.features.size());
+            writeNpy(path("moves"), "i8", {count}, chunk.moves.data(), count * sizeof(int64_t));
+            writeNpy(path("results"), "f4", {count}, chunk.results.data(), count * sizeof(float));
+            writeNpy(path("move_numbers"), "i4", {count}, chunk.moveNumbers.data(), count * sizeof(int32_t));
+
+            shards++;
+        }
+
+        return shards;
+
+    }
+
+    /**
+     *
+     * @param count number of samples
+     * @return the shape of the features of the samples
+     */
+    std::vector<long> SGFDataset::getFeatureShape(unsigned count) const {
+        if (packed){
+            return {long(count), long(planes), packedSize(side)};
+        }
+        if (channelsFirst){
+            return {long(count), long(planes), long(side), long(side)};
+        }
+        return {long(count), long(side), long(side), long(planes)};
+    }
+
+    const std::vector<std::string>& SGFDataset::getFiles() const {
+        return files;
+    }
+
+    const std::vector<std::pair<std::string, std::string>>& SGFDataset::getSkipped() const {
+        return skipped;
+    }
+
+    /**
+     *
+     * @return the number of bytes of features in each sample
+     */
+    unsigned SGFDataset::getSampleSize() const {
+        return packed ? planes * packedSize(side) : planes * side * side;
+    }
+
+    /**
+     *
+     * replays the main line of a game and takes a sample from every position that a move was played in
+     *
+     * @param file index of the file to read
+     * @param samples filled with the samples of the game
+     */
+    void SGFDataset::readGame(unsigned file, Samples& samples) const {
+
+        std::ifstream input(files[file]);
+        if (not input.good()){
+            throw FileNotFoundException(files[file]);
+        }
+
+        std::string text = std::string(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+
+        // warnings go through python, which this thread can't call without the GIL
+        auto tree = SGF::loadSGF(text, true, true, true);
+        GoGame game(tree);
+
+        if (game.getSide() != side){
+            throw std::domain_error("the game is played on a " + std::to_string(game.getSide()) + "x" +
+                                    std::to_string(game.getSide()) + " board");
+        }
+
+        // the result is read from the SGF, draws and games without a result count as 0
+        Stone winner = EMPTY;
+        auto properties = game.getProperties();
+        if (properties.count("RE") and not properties.at("RE").empty() and not properties.at("RE")[0].empty()){
+            char first = properties.at("RE")[0][0];
+            winner = first == 'B' ? BLACK : first == 'W' ? WHITE : EMPTY;
+        }
+
+        unsigned sampleSize = getSampleSize();
+        int32_t moveNumber = 0;
+
+        for (const auto& item : game.getDefaultSequence()){
+
+            if (not std::holds_alternative<Move>(item)){
+                game.addStones(std::get<std::unordered_set<Move>>(item));
+                continue;
+            }
+
+            Move move = std::get<Move>(item);
+
+            if (move.isResign()){
+                break;
+            }
+
+            // some records have two moves in a row by the same player
+            if (move.getStone() != game.getActivePlayer()){
+                game.setActivePlayer(move.getStone());
+            }
+
+            unsigned symmetry = augment ? mixBits(mixBits(seed + file) + moveNumber) % SYMMETRIES : 0;
+
+            samples.features.resize(samples.features.size() + sampleSize);
+            uint8_t* output = samples.features.data() + samples.features.size() - sampleSize;
+
+            if (packed){
+                writePackedFeatures(game, features, output, symmetry);
+            }
+            else {
+                writeFeatures(game, features, output, symmetry, channelsFirst);
+            }
+
+            if (move.isPass()){
+                samples.moves.push_back(side * side);
+            }
+            else {
+                Move target = move.transform(symmetry, side);
+                samples.moves.push_back(target.getX() * side + target.getY());
+            }
+
+            samples.results.push_back(winner == EMPTY ? 0 : winner == move.getStone() ? 1 : -1);
+            samples.moveNumbers.push_back(moveNumber);
+
+            game.playStone(move);
+            moveNumber++;
+        }
+
+    }
+
+}
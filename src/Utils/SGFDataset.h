@@ -0,0 +1,81 @@
+#ifndef SENTE_SGFDATASET_H
+#define SENTE_SGFDATASET_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <utility>
+
+#include "../Game/GoGame.h"
+
+namespace sente::utils {
+
+    /**
+     *
+     * training samples taken from the positions of games, one entry per position in each of the vectors
+     *
+     */
+    struct Samples {
+
+        std::vector<uint8_t> features; // (samples, side, side, planes), (samples, planes, side, side) or packed
+        std::vector<int64_t> moves; // move played in the position, x * side + y or side * side for a pass
+        std::vector<float> results; // 1 if the player to move won the game, -1 if they lost and 0 otherwise
+        std::vector<int32_t> moveNumbers; // number of moves played before the position
+
+        [[nodiscard]] unsigned size() const;
+
+        void append(const Samples& other, unsigned begin, unsigned end, unsigned sampleSize);
+        void clear();
+
+    };
+
+    /**
+     *
+     * turns a collection of SGF files into training samples. The main line of each game is replayed by the rules of
+     * the game, and every move gives a sample of the position it was played in. Files are read on several threads and
+     * the samples are handed out in chunks, so the whole collection never has to fit in memory
+     *
+     */
+    class SGFDataset {
+    public:
+
+        SGFDataset(const std::vector<std::string>& paths, std::vector<std::string> features, unsigned side,
+                   unsigned chunkSize, unsigned threads, bool packed, bool channelsFirst, bool augment,
+                   uint64_t seed);
+
+        void reset();
+        bool nextChunk(Samples& chunk);
+        unsigned writeShards(const std::string& directory, const std::string& prefix);
+
+        [[nodiscard]] std::vector<long> getFeatureShape(unsigned count) const;
+
+        [[nodiscard]] const std::vector<std::string>& getFiles() const;
+        [[nodiscard]] const std::vector<std::pair<std::string, std::string>>& getSkipped() const;
+
+    private:
+
+        std::vector<std::string> files;
+        std::vector<std::string> features;
+        unsigned side;
+        unsigned planes; // number of planes the features take up
+        unsigned chunkSize;
+        unsigned threads;
+        bool packed;
+        bool channelsFirst;
+        bool augment;
+        uint64_t seed;
+
+        unsigned nextFile;
+        Samples pending; // samples read but not yet handed out, in the order of the files
+        unsigned pendingStart; // first sample of pending that has not been handed out
+
+        std::vector<std::pair<std::string, std::string>> skipped; // files that could not be read and why
+
+        [[nodiscard]] unsigned getSampleSize() const;
+        void readGame(unsigned file, Samples& samples) const;
+
+    };
+
+}
+
+#endif //SENTE_SGFDATASET_H
@@ -16,6 +16,9 @@ namespace sente::utils{
         std::string message;
 
         switch (type){
+            case LEGAL:
+                message = "The Desired move " + std::string(move) + " is legal\n";
+                break;
             case OFF_BOARD:
                 message = "The Desired move " + std::string(move) + " is beyond the edge of the go board (check your board size)\n";
                 break;
@@ -30,6 +33,13 @@ namespace sente::utils{
                 break;
             case KO_POINT:
                 message = "The Desired move " + std::string(move) + " lies on a Ko point\n";
+                break;
+            case SUPERKO:
+                message = "The Desired move " + std::string(move) + " would repeat a previous board position (superko)\n";
+                break;
+            case GAME_OVER:
+                message = "Game cannot be forfeited; the game is already over\n";
+                break;
         }
 
         return message.c_str();
@@ -9,16 +9,12 @@
 #include <exception>
 
 #include "../Game/Move.h"
+#include "../Game/GoComponents.h"
 
 namespace sente::utils{
 
-        enum IllegalMoveType {
-            OFF_BOARD,
-            OCCUPIED_POINT,
-            WRONG_COLOR,
-            SELF_CAPTURE,
-            KO_POINT
-        };
+        // an illegal move is described by the status GoGame::getMoveStatus reports for it
+        typedef MoveStatus IllegalMoveType;
 
         class FileNotFoundException : public std::domain_error{
         public:
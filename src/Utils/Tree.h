@@ -6,6 +6,7 @@
 #define SENTE_TREE_H
 
 #include <vector>
+#include <algorithm>
 #include <memory>
 #include <ciso646>
 
@@ -122,6 +123,39 @@ namespace sente::utils{
             }
         }
 
+        /**
+         *
+         * makes an independent copy of the tree (copying a Tree shares its nodes), with the cursor of the copy at the
+         * same node as the cursor of this tree
+         *
+         * @return copy of the tree
+         */
+        Tree deepCopy() const {
+
+            Tree copy;
+
+            copy.depth = depth;
+            copy.size = size;
+            copy.root = copyNode(*root, nullptr);
+
+            // find the path from the root to the cursor
+            std::vector<unsigned> path;
+            for (auto node = cursor; node->parent != nullptr; node = node->parent){
+                auto& siblings = node->parent->children;
+                path.push_back(std::find_if(siblings.begin(), siblings.end(), [&](const auto& sibling){
+                    return sibling.get() == node;
+                }) - siblings.begin());
+            }
+
+            // follow the same path in the copy
+            copy.cursor = copy.root.get();
+            for (auto index = path.rbegin(); index != path.rend(); index++){
+                copy.cursor = copy.cursor->children[*index].get();
+            }
+
+            return copy;
+        }
+
         void advanceToRoot(){
             cursor = root.get();
             depth = 0;
@@ -197,6 +231,14 @@ namespace sente::utils{
 
     private:
 
+        static std::shared_ptr<TreeNode<Type>> copyNode(const TreeNode<Type>& node, TreeNode<Type>* parent){
+            auto copy = std::make_shared<TreeNode<Type>>(node.payload, parent);
+            for (const auto& child : node.children){
+                copy->children.push_back(copyNode(*child, copy.get()));
+            }
+            return copy;
+        }
+
         unsigned depth; // 4 bytes
         unsigned size; // 4 bytes
 
@@ -4,13 +4,19 @@
  *
  */
 
+#include <utility>
+
 #include <pybind11/stl.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/functional.h>
 
 #include "Utils/SGF/SGF.h"
 #include "Game/GoGame.h"
+#include "Game/MCTS.h"
+#include "Game/Playout.h"
 #include "Utils/Numpy.h"
+#include "Utils/PythonEvaluator.h"
+#include "Utils/EvaluationQueue.h"
 #include "Utils/SenteExceptions.h"
 #include "Utils/GTP/DefaultSession.h"
 
@@ -64,6 +70,84 @@ std::unordered_set<sente::Move> getHandicapStones(unsigned handicap){
 
 }
 
+/**
+ *
+ * binds the board class of a single size to python as "Board<side>" (ie. Board19)
+ *
+ * @param module module to add the class to
+ */
+template<unsigned side>
+void bindBoard(py::module& module){
+
+    std::string name = "Board" + std::to_string(side);
+
+    py::class_<sente::Board<side>>(module, name.c_str())
+        .def(py::init<bool, bool>(),
+             py::arg("use_ascii") = false,
+             py::arg("lower_left_origin") = false)
+        .def(py::init<std::array<std::array<sente::Stone, side>, side>>())
+        .def("get_side", &sente::Board<side>::getSide,
+            R"pbdoc(
+                get the length of the side of the board
+
+                :return: the length of the side of the board
+            )pbdoc")
+        .def("play", &sente::Board<side>::playStone,
+            py::arg("move"),
+            py::call_guard<py::gil_scoped_release>(),
+            R"pbdoc(
+                play a stone on the board
+
+                :param move: the move object to play
+            )pbdoc")
+        .def("get_stone", [](const sente::Board<side>& board, unsigned x, unsigned y){
+                return board.getSpace(x - 1, y - 1).getStone();
+            }, R"pbdoc(
+                get the stone located on the specified point.
+
+                :param x: The x co-ordinate to get the stone for.
+                :param y: The y co-ordinate to get the stone for.
+                :return: the stone located at specified point
+            )pbdoc")
+        .def("numpy", [](const sente::Board<side>& board, const py::object& out, const py::object& dtype,
+                         bool packed){
+                return sente::utils::getBoardArray(side, sente::PointSet(board.getStones(sente::BLACK)),
+                                                   sente::PointSet(board.getStones(sente::WHITE)), out, dtype, packed);
+            },
+            py::arg("out") = py::none(),
+            py::arg("dtype") = py::none(),
+            py::arg("packed") = false,
+            R"pbdoc(
+                get a numpy array of the stones on the board, with 1 for black stones, -1 for white stones and 0 for
+                empty points. ``array[x, y]`` holds the point ``(x + 1, y + 1)``, the same layout as ``Game.numpy``.
+
+                :param out: array with the shape ``(side, side)`` to write the stones into, or ``None`` to make a new one
+                :param dtype: dtype of the array (``int8``, ``float16`` or ``float32``), ``int8`` by default
+                :param packed: pack the black stones and the white stones into bits instead, giving a ``uint8`` array
+                    with the shape ``(2, ceil(side * side / 8))`` (see ``sente.unpack``)
+                :return: the array of stones
+            )pbdoc")
+        .def("__str__", [](const sente::Board<side>& board){
+            return std::string(board);
+        })
+        .def("__eq__", &sente::Board<side>::operator==,
+            "equality operator")
+        .def("__ne__", [](const sente::Board<side>& us, const sente::Board<side>& other){
+            return not (us == other);
+        });
+}
+
+/**
+ *
+ * binds the board class of every supported size
+ *
+ * @param module module to add the classes to
+ */
+template<unsigned... offsets>
+void bindBoards(py::module& module, std::integer_sequence<unsigned, offsets...>){
+    (bindBoard<sente::MIN_BOARD_SIZE + offsets>(module), ...);
+}
+
 PYBIND11_MODULE(sente, module){
 
     module.doc() = R"pbdoc(
@@ -80,6 +164,7 @@ PYBIND11_MODULE(sente, module){
 
             objects/stone
             objects/rules
+            objects/ko_rule
             objects/results
             objects/Move
             objects/Boards
@@ -137,6 +222,76 @@ PYBIND11_MODULE(sente, module){
         )pbdoc")
         .export_values();
 
+    py::enum_<sente::KoRule>(module, "ko_rule", R"pbdoc(
+            An enumeration for the rule used to prevent repeated board positions.
+
+            .. code-block:: python
+
+                >>> game = sente.Game(rules=sente.rules.CHINESE, ko_rule=sente.ko_rule.POSITIONAL_SUPERKO)
+
+        )pbdoc")
+        .value("SIMPLE_KO", sente::KoRule::SIMPLE_KO, R"pbdoc(
+            Only immediately re-taking a ko is illegal.
+        )pbdoc")
+        .value("POSITIONAL_SUPERKO", sente::KoRule::POSITIONAL_SUPERKO, R"pbdoc(
+            `Positional superko <https://senseis.xmp.net/?Superko>`_: a move may not recreate any previous board position.
+        )pbdoc")
+        .value("SITUATIONAL_SUPERKO", sente::KoRule::SITUATIONAL_SUPERKO, R"pbdoc(
+            `Situational superko <https://senseis.xmp.net/?Superko>`_: a move may not recreate any previous board position with the same player to move.
+        )pbdoc");
+
+    py::enum_<sente::MoveStatus>(module, "move_status", R"pbdoc(
+            An enumeration for the result of checking a move against the rules, returned by ``Game.try_play``.
+
+            .. code-block:: python
+
+                >>> game = sente.Game()
+                >>> game.try_play(4, 4)
+                <move_status.LEGAL: 0>
+                >>> game.try_play(4, 4)
+                <move_status.OCCUPIED_POINT: 2>
+
+        )pbdoc")
+        .value("LEGAL", sente::LEGAL, R"pbdoc(
+            The move is legal.
+        )pbdoc")
+        .value("OFF_BOARD", sente::OFF_BOARD, R"pbdoc(
+            The move is beyond the edge of the board.
+        )pbdoc")
+        .value("OCCUPIED_POINT", sente::OCCUPIED_POINT, R"pbdoc(
+            The move lies on a point that already has a stone on it.
+        )pbdoc")
+        .value("WRONG_COLOR", sente::WRONG_COLOR, R"pbdoc(
+            It is not the turn of the player making the move.
+        )pbdoc")
+        .value("SELF_CAPTURE", sente::SELF_CAPTURE, R"pbdoc(
+            The move would capture the player's own stones.
+        )pbdoc")
+        .value("KO_POINT", sente::KO_POINT, R"pbdoc(
+            The move immediately re-takes a ko.
+        )pbdoc")
+        .value("SUPERKO", sente::SUPERKO, R"pbdoc(
+            The move would repeat a previous board position.
+        )pbdoc")
+        .value("GAME_OVER", sente::GAME_OVER, R"pbdoc(
+            The move resigns a game that is already over.
+        )pbdoc");
+
+    py::enum_<sente::SelectionRule>(module, "selection_rule", R"pbdoc(
+            An enumeration for the formula ``sente.MCTS`` uses to pick which move to search next.
+
+            .. code-block:: python
+
+                >>> search = sente.MCTS(selection=sente.selection_rule.PUCT)
+
+        )pbdoc")
+        .value("UCT", sente::UCT, R"pbdoc(
+            `Upper confidence bounds applied to trees <https://en.wikipedia.org/wiki/Monte_Carlo_tree_search>`_, which ignores the policy of the evaluator.
+        )pbdoc")
+        .value("PUCT", sente::PUCT, R"pbdoc(
+            The variant of UCT used by AlphaZero, which explores each move in proportion to the policy of the evaluator.
+        )pbdoc");
+
     py::class_<sente::Vertex>(module, "Vertex", R"pbdoc(
                 a class that represents a Vertex on a go board
 
@@ -208,6 +363,23 @@ PYBIND11_MODULE(sente, module){
             :return: :ref:`sente.stone <stone>` object that the move contains
         )pbdoc")
         .def("get_vertex", &sente::Move::getVertex)
+        .def("transform", [](const sente::Move& move, unsigned symmetry, unsigned side, bool inverse){
+            return move.transform(inverse ? sente::invertSymmetry(symmetry) : symmetry, side);
+        },
+        py::arg("symmetry"),
+        py::arg("side") = 19,
+        py::arg("inverse") = false,
+        R"pbdoc(
+            rotates and reflects the move in the same way as ``Game.numpy`` with the same symmetry, so that the move
+            played in a position can be used as the target for the transformed features. Passes and resignations are
+            not changed.
+
+            :param symmetry: number from 0 to 7 of the rotation and reflection to apply (0 leaves the move alone)
+            :param side: side length of the board the move is played on
+            :param inverse: undo the symmetry instead, which maps a move chosen on the transformed board back onto the
+                game
+            :return: the transformed move
+        )pbdoc")
         .def("__eq__", &sente::Move::operator==)
         .def("__ne__", &sente::Move::operator!=)
         .def("__str__", [](const sente::Move& move){
@@ -225,118 +397,7 @@ PYBIND11_MODULE(sente, module){
             return "<sente.Move " + std::string(move) + ">";
         });
 
-    py::class_<sente::Board<19>>(module, "Board19")
-        .def(py::init<bool, bool>(),
-             py::arg("use_ascii") = false,
-             py::arg("lower_left_origin") = false)
-        .def(py::init<std::array<std::array<sente::Stone, 19>, 19>>())
-        .def("get_side", &sente::Board<19>::getSide,
-            R"pbdoc(
-                get the length of the side of the board
-
-                :return: the length of the side of the board (19)
-            )pbdoc")
-        .def("play", &sente::Board<19>::playStone,
-            py::arg("move"),
-            py::call_guard<py::gil_scoped_release>(),
-            R"pbdoc(
-                play a stone on the board
-
-                :param move: the move object to play
-            )pbdoc")
-        .def("get_stone", [](const sente::Board<19>& board, unsigned x, unsigned y){
-                return board.getSpace(x - 1, y - 1).getStone();
-            }, R"pbdoc(
-                get the stone located on the specified point.
-
-                :param x: The x co-ordinate to get the stone for.
-                :param y: The y co-ordinate to get the stone for.
-                :return: the stone located at specified point
-            )pbdoc")
-        .def("__str__", [](const sente::Board<19>& board){
-            return std::string(board);
-        })
-        .def("__eq__", &sente::Board<19>::operator==,
-            "equality operator")
-        .def("__ne__", [](const sente::Board<19>& us, const sente::Board<19>& other){
-            return not (us == other);
-        });
-
-    py::class_<sente::Board<13>>(module, "Board13")
-        .def(py::init<bool, bool>(),
-             py::arg("use_ascii") = false,
-             py::arg("lower_left_origin") = false)
-        .def(py::init<std::array<std::array<sente::Stone, 13>, 13>>())
-        .def("get_side", &sente::Board<13>::getSide,
-            R"pbdoc(
-                get the length of the side of the board
-
-                :return: the length of the side of the board (13)
-            )pbdoc")
-        .def("play", &sente::Board<13>::playStone,
-            py::arg("move"),
-            py::call_guard<py::gil_scoped_release>(),
-            R"pbdoc(
-                play a stone on the board
-
-                :param move: the move object to play
-            )pbdoc")
-        .def("get_stone", [](const sente::Board<13>& board, unsigned x, unsigned y){
-                 return board.getSpace(x - 1, y - 1).getStone();
-            },
-            R"pbdoc(
-                get the stone located on the specified point.
-
-                :param x: The x co-ordinate to get the stone for.
-                :param y: The y co-ordinate to get the stone for.
-                :return: the stone located at specified point
-            )pbdoc")
-        .def("__str__", [](const sente::Board<13>& board){
-            return std::string(board);
-        })
-        .def("__eq__", &sente::Board<13>::operator==,
-             "equality operator")
-        .def("__ne__", [](const sente::Board<13>& us, const sente::Board<13>& other){
-            return not (us == other);
-        });
-
-    py::class_<sente::Board<9>>(module, "Board9")
-        .def(py::init<bool, bool>(),
-                py::arg("use_ascii") = false,
-                py::arg("lower_left_origin") = false)
-        .def(py::init<std::array<std::array<sente::Stone, 9>, 9>>())
-        .def("get_side", &sente::Board<9>::getSide,
-            R"pbdoc(
-                get the length of the side of the board
-
-                :return: the length of the side of the board (9)
-            )pbdoc")
-        .def("play", &sente::Board<9>::playStone,
-            py::arg("move"),
-            py::call_guard<py::gil_scoped_release>(),
-            R"pbdoc(
-                play a stone on the board
-
-                :param move: the move object to play
-            )pbdoc")
-        .def("get_stone", [](const sente::Board<9>& board, unsigned x, unsigned y){
-                return board.getSpace(x - 1, y - 1).getStone();
-            },
-            R"pbdoc(
-                get the stone located on the specified point.
-
-                :param x: The x co-ordinate to get the stone for.
-                :param y: The y co-ordinate to get the stone for.
-                :return: the stone located at specified point
-            )pbdoc")
-        .def("__str__", [](const sente::Board<9>& board){
-                return std::string(board);
-            })
-        .def("__eq__", &sente::Board<9>::operator==,
-             "equality operator")
-        .def("__ne__", [](const sente::Board<9>& us, const sente::Board<9>& other){
-                return not (us == other);
-            });
+    bindBoards(module, std::make_integer_sequence<unsigned, sente::MAX_BOARD_SIZE - sente::MIN_BOARD_SIZE + 1>{});
 
     module.def("get_handicap_stones", &getHandicapStones,
           R"pbdoc(
@@ -347,6 +408,57 @@ PYBIND11_MODULE(sente, module){
                 :return: list of stones to use as a handicap
           )pbdoc");
 
+    module.def("numpy", &sente::utils::getBatchFeatures,
+               py::arg("games"),
+               py::arg("features") = std::vector<std::string>{"Black Stones", "White Stones", "Empty Points", "Ko Points"},
+               py::arg("out") = py::none(),
+               py::arg("threads") = 0,
+               py::arg("symmetries") = std::vector<unsigned>{},
+               py::arg("dtype") = py::none(),
+               py::arg("channels_first") = false,
+               py::arg("packed") = false,
+          R"pbdoc(
+
+                generates the features of many games at once (see ``Game.numpy``), which is much faster than stacking the
+                arrays of each game. The games are split between several threads, which run without holding the GIL.
+
+                :param games: list of games to generate the features of, all played on the same board size
+                :param features: names of the features to include
+                :param out: array with the shape ``(len(games), side, side, planes)`` to write the features into, so
+                    that the same array can be filled again and again. A new array is made if this is ``None``
+                :param threads: number of threads to use (0 uses one thread per core)
+                :param symmetries: rotation and reflection to apply to each game (see ``Game.numpy``). Every game is left
+                    as it is if this is empty
+                :param dtype: dtype of the array (``uint8``, ``int8``, ``float16`` or ``float32``). Defaults to the
+                    dtype of ``out``, or ``uint8`` if a new array is made
+                :param channels_first: put the planes before the points, giving the shape
+                    ``(len(games), planes, side, side)``
+                :param packed: pack the points of each plane into bits, giving a ``uint8`` array with the shape
+                    ``(len(games), planes, ceil(side * side / 8))`` (see ``sente.unpack``)
+                :return: the filled array
+          )pbdoc");
+
+    module.def("unpack", &sente::utils::unpackFeatures,
+               py::arg("packed"),
+               py::arg("side"),
+               py::arg("out") = py::none(),
+               py::arg("dtype") = py::none(),
+               py::arg("channels_first") = false,
+          R"pbdoc(
+
+                unpacks features or boards that were packed into bits with ``packed=True``. This gives the same array as
+                ``numpy.unpackbits`` followed by a reshape, but writes the type and layout a network needs in one pass.
+
+                :param packed: ``uint8`` array with the shape ``(..., planes, ceil(side * side / 8))``
+                :param side: side length of the board the features are from
+                :param out: array to write the unpacked features into, or ``None`` to make a new one
+                :param dtype: dtype of the array (``uint8``, ``int8``, ``float16`` or ``float32``). Defaults to the
+                    dtype of ``out``, or ``uint8`` if a new array is made
+                :param channels_first: give the shape ``(..., planes, side, side)`` rather than
+                    ``(..., side, side, planes)``
+                :return: the unpacked array
+          )pbdoc");
+
     py::class_<sente::GoGame>(module, "Game", R"pbdoc(
 
             The Sente Game object.
@@ -355,18 +467,21 @@ PYBIND11_MODULE(sente, module){
             For more on the difference between ``sente.Game`` and ``sente.Board`` see :ref:`Boards vs Games`.
 
         )pbdoc")
-        .def(py::init<unsigned, sente::Rules, double, std::unordered_set<sente::Move>>(),
+        .def(py::init<unsigned, sente::Rules, double, std::unordered_set<sente::Move>, sente::KoRule>(),
             py::arg("board_size") = 19,
             py::arg("rules") = sente::Rules::CHINESE,
             py::arg("komi") = INFINITY,
             py::arg("handicap") = std::unordered_set<sente::Move>{sente::Move::nullMove},
+            py::arg("ko_rule") = sente::KoRule::SIMPLE_KO,
             R"pbdoc(
                 initializes a go game with a specified board size and rules
 
-                :param board_size: size of the board to play
+                :param board_size: size of the board to play (between 2 and 25)
                 :param rules: to play the game by
                 :param komi: of the game
                 :param handicap: handicap to give the black player
+                :param ko_rule: rule used to prevent repeated positions (superko requires Chinese or Tromp-Taylor rules)
+                :raises ValueError: If the board size is not supported or a superko rule is used with Japanese or Korean rules
             )pbdoc")
         .def("get_active_player", &sente::GoGame::getActivePlayer,
             R"pbdoc(
@@ -446,6 +561,36 @@ PYBIND11_MODULE(sente, module){
                 :param y: y co-ordinate of the point to locate.
                 :return: a :ref:`sente.stone <stone>` object representing the specified point
             )pbdoc")
+        .def("get_liberties", [](const sente::GoGame& game, unsigned x, unsigned y){
+                return game.getLiberties(x - 1, y - 1);
+            },
+            py::arg("x"),
+            py::arg("y"),
+            R"pbdoc(
+                get the liberties of the group of stones on a point.
+
+                Liberties are kept up to date as moves are played, so this does not search the board.
+
+                :param x: x co-ordinate of a stone in the group.
+                :param y: y co-ordinate of a stone in the group.
+                :return: list of empty moves, one for each liberty of the group
+                :raises IndexError: If the point is not on the board
+                :raises ValueError: If there is no stone on the point
+            )pbdoc")
+        .def("count_liberties", [](const sente::GoGame& game, unsigned x, unsigned y){
+                return game.countLiberties(x - 1, y - 1);
+            },
+            py::arg("x"),
+            py::arg("y"),
+            R"pbdoc(
+                count the liberties of the group of stones on a point.
+
+                :param x: x co-ordinate of a stone in the group.
+                :param y: y co-ordinate of a stone in the group.
+                :return: the number of liberties of the group
+                :raises IndexError: If the point is not on the board
+                :raises ValueError: If there is no stone on the point
+            )pbdoc")
         .def("play", [](sente::GoGame& game, unsigned x, unsigned y){
                 game.playStone(x - 1, y - 1);
             },
@@ -515,6 +660,64 @@ PYBIND11_MODULE(sente, module){
                 :raises ValueError: If a valid Move object is not passed
 
             )pbdoc")
+        .def("try_play", [](sente::GoGame& game, unsigned x, unsigned y){
+                return game.tryPlay(x - 1, y - 1);
+            },
+            py::arg("x"),
+            py::arg("y"),
+            py::call_guard<py::gil_scoped_release>(),
+            R"pbdoc(
+                Plays a stone on the board at the specified location if the move is legal.
+
+                Unlike ``Game.play``, an illegal move does not raise an exception, which makes this method much cheaper
+                when many candidate moves are expected to be rejected.
+
+                :param x: The x co-ordinate of the move to play.
+                :param y: The y co-ordinate of the move to play.
+                :return: ``move_status.LEGAL`` if the move was played, otherwise the rule that the move breaks
+            )pbdoc")
+        .def("try_play", [](sente::GoGame& game, unsigned x, unsigned y, sente::Stone stone){
+                return game.tryPlay(x - 1, y - 1, stone);
+            },
+            py::arg("x"),
+            py::arg("y"),
+            py::arg("stone"),
+            py::call_guard<py::gil_scoped_release>(),
+            R"pbdoc(
+                Plays a stone on the board at the specified location if the move is legal (see above).
+
+                :param x: The x co-ordinate of the move to play.
+                :param y: The y co-ordinate of the move to play.
+                :param stone: The color of the stone to play.
+                :return: ``move_status.LEGAL`` if the move was played, otherwise the rule that the move breaks
+            )pbdoc")
+        .def("try_play", [](sente::GoGame& game, const sente::Move& move){
+                return game.tryPlay(move);
+            },
+            py::arg("move"),
+            py::call_guard<py::gil_scoped_release>(),
+            R"pbdoc(
+                Plays a move if it is legal (see above).
+
+                :param move: The Move object to play
+                :return: ``move_status.LEGAL`` if the move was played, otherwise the rule that the move breaks
+            )pbdoc")
+        .def("try_play", [](sente::GoGame& game, const py::object& obj){
+                if (obj.is_none()){
+                    // pass if the object is none
+                    return game.tryPlay(sente::Move::pass(game.getActivePlayer()));
+                }
+                else {
+                    throw std::domain_error("cannot play " + std::string(py::str(obj)));
+                }
+            },
+            R"pbdoc(
+                An overloaded extension of the ``try_play`` method that accepts ``None`` as an argument and passes.
+
+                :param move: None
+                :return: ``move_status.LEGAL``
+                :raises ValueError: If a valid Move object is not passed
+            )pbdoc")
         .def("set_active_player", &sente::GoGame::setActivePlayer,
              R"pbdoc(
 
@@ -540,16 +743,142 @@ PYBIND11_MODULE(sente, module){
             R"pbdoc(
                 returns a dictionary containing the scores of the game
 
-                .. Warning:: Sente's automatic scoring does not remove dead stones
+                .. Warning:: Sente's automatic scoring only removes dead stones that have been marked (see ``Game.set_dead_stones``)
 
                 :return: python dictionary containing the scores and result of the game
 
             )pbdoc")
+        .def("score_position", [](const sente::GoGame& game){
+
+                sente::PositionScore score = game.scorePosition();
+
+                py::dict result;
+
+                result[py::cast(sente::BLACK)] = score.black;
+                result[py::cast(sente::WHITE)] = score.white;
+
+                return result;
+            },
+            R"pbdoc(
+                scores the current position without ending the game.
+
+                Unlike ``Game.score``, the game does not need to have ended by both players passing, which makes this
+                method suited to scoring the final positions of playouts. Every stone on the board that has not been marked as
+                dead is counted as alive.
+
+                .. Warning:: Sente's automatic scoring only removes dead stones that have been marked (see ``Game.set_dead_stones``)
+
+                :return: python dictionary containing the score of each player (including komi)
+
+            )pbdoc")
+        .def("run_playouts", [](const sente::GoGame& game, unsigned playouts, unsigned threads, uint64_t seed,
+                                unsigned maxMoves){
+
+                sente::PlayoutResults results;
+
+                {
+                    // the playouts do not touch any python objects
+                    py::gil_scoped_release release;
+                    results = sente::runPlayouts(game, playouts, threads, seed, maxMoves);
+                }
+
+                long side = game.getSide();
+
+                py::dict response;
+
+                response["playouts"] = results.playouts;
+                response[py::cast(sente::BLACK)] = results.blackWins;
+                response[py::cast(sente::WHITE)] = results.whiteWins;
+                response["black_ownership"] = py::array_t<unsigned>({side, side}, results.blackOwnership.data());
+                response["white_ownership"] = py::array_t<unsigned>({side, side}, results.whiteOwnership.data());
+
+                return response;
+            },
+            py::arg("playouts"),
+            py::arg("threads") = 0,
+            py::arg("seed") = 0,
+            py::arg("max_moves") = 0,
+            R"pbdoc(
+                plays random games from the current position and counts who wins them.
+
+                Each playout plays random legal moves that do not fill the player's own eyes until both players pass,
+                and is then scored like ``Game.score_position`` by the rules of the game: area scoring under Chinese and
+                Tromp-Taylor rules, and territory with prisoners (counting the stones captured before the playouts
+                started) under Japanese and Korean rules. The playouts are split between several threads that run
+                without the GIL, and each thread has its own random number generator seeded from ``seed``, so the
+                results only depend on the seed and the number of threads. The game itself is not changed.
+
+                :param playouts: the number of playouts to play
+                :param threads: the number of threads to use (0 uses one thread per core)
+                :param seed: seed for the random number generators
+                :param max_moves: the most moves to play in each playout (0 allows three times the number of points)
+                :return: python dictionary containing the number of playouts, the number of wins of each player and
+                    ``side`` by ``side`` numpy arrays (``"black_ownership"`` and ``"white_ownership"``) counting how
+                    many playouts ended with each point in each player's area
+            )pbdoc")
+        .def("set_dead_stones", &sente::GoGame::setDeadStones,
+            py::arg("stones"),
+            R"pbdoc(
+                marks stones as dead so that they are taken off the board when the game is scored.
+
+                The marks replace any earlier marks and only apply to the current position; they are ignored once the
+                stones on the board change. If the game is already over, it is scored again.
+
+                :param stones: list of moves on the points of the dead stones
+                :raises IndexError: If a point is not on the board
+                :raises ValueError: If there is no stone on a point
+            )pbdoc")
+        .def("set_dead_stones", [](const py::object& self, const py::function& estimator){
+                auto stones = estimator(self).cast<std::vector<sente::Move>>();
+                self.cast<sente::GoGame&>().setDeadStones(stones);
+            },
+            py::arg("estimator"),
+            R"pbdoc(
+                marks the stones chosen by an estimator as dead (see above).
+
+                :param estimator: function that takes the game and returns a list of moves on the points of the dead stones
+            )pbdoc")
+        .def("set_dead_stones_from_territory", &sente::GoGame::setDeadStonesFromTerritory,
+            R"pbdoc(
+                marks the stones inside the territory recorded by the ``TB`` and ``TW`` properties of the current SGF node
+                as dead.
+
+                :raises InvalidSGFException: If a territory point is not valid
+            )pbdoc")
+        .def("get_dead_stones", &sente::GoGame::getDeadStones,
+            R"pbdoc(
+                get the stones that are marked as dead on the current position.
+
+                :return: list of moves on the points of the dead stones
+            )pbdoc")
+        .def("find_dead_stones", &sente::GoGame::findDeadStones,
+            R"pbdoc(
+                finds the stones that are certainly dead, which are the stones inside the pass-alive area of the other
+                player (see ``Game.get_pass_alive_area``).
+
+                Stones that are only dead because they cannot make life in practice are not found, but the result can be
+                passed directly to ``Game.set_dead_stones``.
+
+                :return: list of moves on the points of the dead stones
+            )pbdoc")
+        .def("get_pass_alive_area", &sente::GoGame::getPassAliveArea,
+            py::arg("stone"),
+            R"pbdoc(
+                finds the area that a player owns unconditionally using
+                `Benson's algorithm <https://senseis.xmp.net/?BensonsAlgorithm>`_.
+
+                The area is made up of the player's pass-alive stones, which can never be captured even if the player
+                passes every turn, and the regions those stones enclose in which the opponent can never live.
+
+                :param stone: the color of the player
+                :return: list of moves of the player's color, one for each point of the area
+                :raises ValueError: If the color is EMPTY
+            )pbdoc")
         .def("get_result", &sente::GoGame::getResult,
             R"pbdoc(
                 returns a string representing the results of the game (ie. W+0.5)
 
-                .. Warning:: Sente's automatic scoring does not remove dead stones
+                .. Warning:: Sente's automatic scoring only removes dead stones that have been marked (see ``Game.set_dead_stones``)
 
                 :return: :ref:`sente.stone <stone>` of the winner of the game.
 
@@ -559,7 +888,7 @@ PYBIND11_MODULE(sente, module){
 
                 determines the winner of the game.
 
-                .. Warning:: Sente's automatic scoring does not remove dead stones
+                .. Warning:: Sente's automatic scoring only removes dead stones that have been marked (see ``Game.set_dead_stones``)
 
                 :return: :ref:`sente.stone <stone>` of the winner of the game. Returns sente.stone.EMPTY if the game is
                 still in progress
@@ -584,6 +913,40 @@ PYBIND11_MODULE(sente, module){
 
                 :param steps: the number to steps to step up
             )pbdoc")
+        .def("start_playout", &sente::GoGame::startPlayout,
+            R"pbdoc(
+                starts a playout.
+
+                Moves played during a playout are checked and applied (including captures, ko and superko) like any
+                other move, but they are not added to the game tree. This makes them much faster to play, which is
+                useful for random playouts and search rollouts. Resigning during a playout ends the game until the
+                playout is ended, but does not record a result in the game tree.
+
+                .. code-block:: python
+
+                    >>> game = sente.Game()
+                    >>> game.start_playout()
+                    >>> game.play(4, 4)
+                    >>> game.end_playout()
+                    >>> game.get_point(4, 4)
+                    sente.stone.EMPTY
+
+            )pbdoc")
+        .def("end_playout", &sente::GoGame::endPlayout,
+            R"pbdoc(
+                takes back every move played during the playout and returns to the position the playout started from.
+            )pbdoc")
+        .def("commit_playout", &sente::GoGame::commitPlayout,
+            R"pbdoc(
+                adds the moves played during the playout to the game tree as a variation and ends the playout. The
+                game stays at the end of the new variation.
+            )pbdoc")
+        .def("in_playout", &sente::GoGame::isInPlayout,
+            R"pbdoc(
+                determines whether a playout is currently running
+
+                :return: whether the game is in a playout
+            )pbdoc")
         .def("get_branches", &sente::GoGame::getBranches,
             R"pbdoc(
 
@@ -639,22 +1002,102 @@ PYBIND11_MODULE(sente, module){
 
                 :return: list of legal moves on the current board
             )pbdoc")
+        .def("get_legal_mask", &sente::utils::getLegalMask,
+            py::arg("symmetry") = 0,
+            R"pbdoc(
+                get a mask of the moves that the active player can legally play.
+
+                The mask is a boolean numpy array with one entry for each point of the board followed by one entry for
+                passing. ``mask[:-1].reshape(side, side)`` gives the mask for the board with the same layout as
+                ``Game.numpy``. The legal points are kept up to date as moves are played, so this does not search the
+                board.
+
+                .. warning:: The array is a read-only view of memory inside the game rather than a copy, and the
+                    next call to ``get_legal_mask`` overwrites it. Copy the array if it needs to be kept or changed. A
+                    mask with a symmetry other than 0 is a new array.
+
+                :param symmetry: rotation and reflection to apply to the points of the mask (see ``Game.numpy``)
+                :return: boolean numpy array of length ``side * side + 1``
+            )pbdoc")
+        .def("get_hash", &sente::GoGame::getHash,
+            R"pbdoc(
+                get the Zobrist hash of the stones on the board.
+
+                The hash is updated incrementally as stones are played and captured, so it is an inexpensive key for
+                finding repeated or duplicate positions.
+
+                :return: 64-bit hash of the current board position
+            )pbdoc")
+        .def("get_ko_rule", &sente::GoGame::getKoRule,
+            R"pbdoc(
+                get the rule used to prevent repeated positions
+
+                :return: the ``sente.ko_rule`` of the game
+            )pbdoc")
         .def("is_over", &sente::GoGame::isOver,
              R"pbdoc(
                 determine if the game is over yet
 
                 :return: whether or not the game has ended
             )pbdoc")
+        .def("clone", &sente::GoGame::clone,
+            py::arg("history") = true,
+            R"pbdoc(
+                creates an independent copy of the game that can be played on without affecting this game.
+
+                .. code-block:: python
+
+                    >>> game = sente.Game()
+                    >>> game.play(4, 4)
+                    >>> branch = game.clone(history=False)
+                    >>> branch.play(16, 16)
+                    >>> game.get_point(16, 16)
+                    sente.stone.EMPTY
+
+                :param history: whether to copy the game tree. If ``False``, the copy starts from the current position
+                    with no moves before it (but keeps the ko point, the prisoners, the last seven moves for the
+                    history features and, under superko, the previous positions), which is much faster to create.
+                :return: copy of the game
+            )pbdoc")
+        .def("__copy__", [](const sente::GoGame& game){
+                return game.clone();
+            })
+        .def("__deepcopy__", [](const sente::GoGame& game, const py::dict& memo){
+                (void) memo;
+                return game.clone();
+            })
         .def("get_board", &sente::GoGame::copyBoard,
              R"pbdoc(
                 Get a copy of the board object that the game is updating internally.
 
                 :return: a ``sente.Board`` object that represents the board to be played.
             )pbdoc")
-        .def("numpy", &sente::utils::getFeatures)
-        .def("numpy", [](const sente::GoGame& game){
-                return sente::utils::getFeatures(game, {"Black Stones", "White Stones", "Empty Points", "Ko Points"});
-            })
+        .def("numpy", &sente::utils::getFeatures,
+            py::arg("features") = std::vector<std::string>{"Black Stones", "White Stones", "Empty Points", "Ko Points"},
+            py::arg("symmetry") = 0,
+            py::arg("out") = py::none(),
+            py::arg("dtype") = py::none(),
+            py::arg("channels_first") = false,
+            py::arg("packed") = false,
+            R"pbdoc(
+                generates a numpy array with the shape ``(side, side, planes)`` of features of the current position.
+
+                The symmetry rotates and reflects the board, which is an easy way to make more training data from the
+                same games. The board is transposed if bit 2 of the symmetry is set, then flipped along the first axis
+                if bit 0 is set and along the second axis if bit 1 is set, so symmetry 0 leaves the board as it is.
+                ``Move.transform`` moves a move to the same place.
+
+                :param features: names of the features to include (see the numpy tutorial)
+                :param symmetry: number from 0 to 7 of the rotation and reflection to apply to the board
+                :param out: array to write the features into rather than making a new one
+                :param dtype: dtype of the array (``uint8``, ``int8``, ``float16`` or ``float32``). Defaults to the
+                    dtype of ``out``, or ``uint8`` if a new array is made
+                :param channels_first: put the planes before the points, giving the shape ``(planes, side, side)``
+                    that PyTorch expects
+                :param packed: pack the points of each plane into bits, giving a ``uint8`` array with the shape
+                    ``(planes, ceil(side * side / 8))`` that takes up an eighth of the space (see ``sente.unpack``)
+                :return: numpy array of features
+            )pbdoc")
         .def("get_properties", [](const sente::GoGame& game) -> py::dict{
 
                 py::dict response;
@@ -712,6 +1155,280 @@ PYBIND11_MODULE(sente, module){
             return std::string(game);
         });
 
+    py::class_<sente::MCTS, std::shared_ptr<sente::MCTS>>(module, "MCTS", R"pbdoc(
+            Monte Carlo tree search over sente games, run entirely in C++.
+
+            .. code-block:: python
+
+                >>> game = sente.Game(9)
+                >>> search = sente.MCTS(playouts=2000, threads=4)
+                >>> move = search.search(game)
+                >>> game.play(move)
+
+            The tree is kept between searches, so searching again after one or two moves reuses the part of the tree
+            below the moves that were played.
+
+        )pbdoc")
+        .def(py::init([](unsigned playouts, unsigned threads, unsigned batchSize, sente::SelectionRule selection,
+                         double exploration, double virtualLoss, uint64_t seed, const py::object& evaluator,
+                         const std::vector<std::string>& features){
+
+                sente::SearchOptions options;
+                options.playouts = playouts;
+                options.threads = threads;
+                options.batchSize = batchSize;
+                options.selection = selection;
+                options.exploration = exploration;
+                options.virtualLoss = virtualLoss;
+                options.seed = seed;
+
+                std::shared_ptr<sente::Evaluator> leafEvaluator;
+
+                if (py::isinstance<sente::utils::EvaluationQueue>(evaluator)){
+                    // share the queue's batches with everything else that uses it
+                    leafEvaluator = evaluator.cast<std::shared_ptr<sente::utils::EvaluationQueue>>();
+                }
+                else if (not evaluator.is_none()){
+                    leafEvaluator = std::make_shared<sente::utils::PythonEvaluator>(evaluator.cast<py::function>(),
+                                                                                     features);
+                }
+
+                return std::make_shared<sente::MCTS>(options, leafEvaluator);
+            }),
+            py::arg("playouts") = 1000,
+            py::arg("threads") = 1,
+            py::arg("batch_size") = 1,
+            py::arg("selection") = sente::UCT,
+            py::arg("exploration") = 1.0,
+            py::arg("virtual_loss") = 1.0,
+            py::arg("seed") = 0,
+            py::arg("evaluator") = py::none(),
+            py::arg("features") = std::vector<std::string>{"black_stones", "white_stones", "empty_points", "ko_points"},
+            R"pbdoc(
+                creates a new search
+
+                :param playouts: number of positions to evaluate in each search
+                :param threads: number of threads to search with (0 uses one thread per core)
+                :param batch_size: number of positions each thread collects before calling the evaluator
+                :param selection: the formula used to pick moves to search (``sente.selection_rule``)
+                :param exploration: weight of the exploration term of the formula
+                :param virtual_loss: losses added to a line while a thread is evaluating it, which keeps the threads
+                    from all searching the same line
+                :param seed: seed for the random playouts
+                :param evaluator: function used to evaluate positions, random playouts are used if it is ``None``.
+                    The function is called with a numpy array of features with the shape ``(batch, side, side,
+                    planes)``, where ``planes`` is the number of planes the features take up (binned and history
+                    features take up several), and returns a tuple of the policy, with the shape
+                    ``(batch, side * side + 1)``, and the value of each position for the player to move, from -1 to 1.
+                    The policy uses the same order as ``Game.get_legal_mask``. A ``sente.EvaluationQueue`` can be
+                    passed instead to share batches with other searches
+                :param features: names of the features to pass to the evaluator (see ``Game.numpy``), ignored if the
+                    evaluator is a ``sente.EvaluationQueue``
+            )pbdoc")
+        .def("search", &sente::MCTS::search,
+            py::arg("game"),
+            py::call_guard<py::gil_scoped_release>(),
+            R"pbdoc(
+                searches a position and returns the move that was searched the most. The game is not changed
+
+                :param game: the game to search
+                :return: the best move for the active player
+            )pbdoc")
+        .def("get_visits", [](const sente::MCTS& search){
+                py::dict visits;
+                for (const auto& statistics : search.getStatistics()){
+                    visits[py::cast(statistics.move)] = statistics.visits;
+                }
+                return visits;
+            },
+            R"pbdoc(
+                gets the number of times each move from the last position searched was visited
+
+                :return: dictionary mapping each legal move to its number of visits
+            )pbdoc")
+        .def("get_value", &sente::MCTS::getRootValue,
+            R"pbdoc(
+                gets the average result of the searches of the last position searched
+
+                :return: the expected result for the player to move, from -1 (loss) to 1 (win)
+            )pbdoc")
+        .def("get_root_visits", &sente::MCTS::getRootVisits,
+            R"pbdoc(
+                gets the number of positions evaluated below the last position searched, including the evaluations
+                of earlier searches that were reused
+
+                :return: the number of visits of the root of the tree
+            )pbdoc")
+        .def("clear", &sente::MCTS::clear,
+            R"pbdoc(
+                throws away the search tree
+            )pbdoc");
+
+    py::class_<sente::utils::EvaluationQueue, std::shared_ptr<sente::utils::EvaluationQueue>>(module, "EvaluationQueue", R"pbdoc(
+            Collects positions from many searches (or threads) into batches, so that a neural network is called once
+            for a whole batch instead of once for each caller.
+
+            .. code-block:: python
+
+                >>> queue = sente.EvaluationQueue(network, max_batch_size=256, max_delay=0.002)
+                >>> searches = [sente.MCTS(playouts=800, evaluator=queue) for _ in range(16)]
+
+        )pbdoc")
+        .def(py::init([](const py::function& function, const std::vector<std::string>& features,
+                         unsigned maxBatchSize, double maxDelay){
+                return std::make_shared<sente::utils::EvaluationQueue>(function, features, maxBatchSize,
+                    std::chrono::microseconds(long(maxDelay * 1e6)));
+            }),
+            py::arg("function"),
+            py::arg("features") = std::vector<std::string>{"black_stones", "white_stones", "empty_points", "ko_points"},
+            py::arg("max_batch_size") = 64,
+            py::arg("max_delay") = 0.001,
+            R"pbdoc(
+                creates a new evaluation queue
+
+                :param function: function called with a numpy array of features with the shape
+                    ``(batch, side, side, planes)``, where ``planes`` is the number of planes the features take up,
+                    that returns a tuple of the policy, with the shape
+                    ``(batch, side * side + 1)``, and the value of each position for the player to move.
+                    The array of features is reused for the next batch, so it must be copied to be kept
+                :param features: names of the features to pass to the function (see ``Game.numpy``)
+                :param max_batch_size: the most positions to pass to the function at once
+                :param max_delay: the longest time (in seconds) that a position waits for its batch to fill up
+            )pbdoc")
+        .def("evaluate", [](sente::utils::EvaluationQueue& queue, const std::vector<sente::GoGame*>& games){
+
+                std::vector<sente::Evaluation> evaluations;
+
+                {
+                    // other threads may be waiting on the same batch
+                    py::gil_scoped_release release;
+                    evaluations = queue.evaluate(games);
+                }
+
+                long side = games.empty() ? 0 : long(games.front()->getSide());
+
+                py::array_t<float> policy({long(evaluations.size()), side * side + 1});
+                py::array_t<float> value(long(evaluations.size()));
+
+                for (unsigned i = 0; i < evaluations.size(); i++){
+                    std::copy(evaluations[i].policy.begin(), evaluations[i].policy.end(),
+                              policy.mutable_data(i, 0));
+                    value.mutable_at(i) = float(evaluations[i].value);
+                }
+
+                return py::make_tuple(policy, value);
+            },
+            py::arg("games"),
+            R"pbdoc(
+                evaluates the current positions of some games. The positions are added to the queue and may be
+                evaluated in the same batch as positions from other threads
+
+                :param games: list of games to evaluate, which must all be played on the same board size
+                :return: tuple of the policy and the value of each position
+                :raises ValueError: If a game is None or the games are played on different board sizes
+            )pbdoc")
+        .def_property_readonly("max_batch_size", &sente::utils::EvaluationQueue::getMaxBatchSize,
+            "the most positions passed to the function at once")
+        .def_property_readonly("batches", &sente::utils::EvaluationQueue::getBatches,
+            "the number of times the function has been called")
+        .def_property_readonly("positions", &sente::utils::EvaluationQueue::getPositions,
+            "the number of positions that have been evaluated");
+
+    py::class_<sente::utils::GoEnvBatch>(module, "GoEnvBatch", R"pbdoc(
+            A batch of games that are stepped together, for reinforcement learning.
+
+            Each step plays one action in every game. An action is the index of a point (``x * board_size + y``, with
+            co-ordinates starting at zero) or ``board_size * board_size`` to pass. The observations, legal move masks,
+            rewards and done flags are read-only numpy arrays that are updated in place by every step, and games that
+            end are started over straight away.
+
+            .. code-block:: python
+
+                >>> env = sente.GoEnvBatch(256, board_size=9)
+                >>> observations, legal = env.reset()
+                >>> observations, legal, rewards, done = env.step(actions)
+
+        )pbdoc")
+        .def(py::init<unsigned, unsigned, sente::Rules, double, sente::KoRule, std::vector<std::string>, unsigned, unsigned>(),
+            py::arg("count"),
+            py::arg("board_size") = 19,
+            py::arg("rules") = sente::Rules::CHINESE,
+            py::arg("komi") = INFINITY,
+            py::arg("ko_rule") = sente::KoRule::SIMPLE_KO,
+            py::arg("features") = std::vector<std::string>{"black_stones", "white_stones", "empty_points", "ko_points"},
+            py::arg("max_moves") = 0,
+            py::arg("threads") = 0,
+            R"pbdoc(
+                creates a batch of games
+
+                :param count: number of games in the batch
+                :param board_size: size of the boards (between 2 and 25)
+                :param rules: rules to play the games by
+                :param komi: komi of the games
+                :param ko_rule: rule used to prevent repeated positions
+                :param features: names of the features that make up the observations (see ``Game.numpy``)
+                :param max_moves: number of moves after which a game is scored even if the players have not passed
+                    (0 allows twice the number of points on the board)
+                :param threads: number of threads to step the games on (0 uses one thread per core)
+                :raises ValueError: if a feature is unknown
+            )pbdoc")
+        .def("reset", [](const py::object& self){
+                {
+                    py::gil_scoped_release release;
+                    self.cast<sente::utils::GoEnvBatch&>().reset();
+                }
+                return py::make_tuple(sente::utils::getObservations(self), sente::utils::getLegalMasks(self));
+            },
+            R"pbdoc(
+                starts every game over
+
+                :return: tuple of the observations and the legal move masks
+            )pbdoc")
+        .def("step", [](const py::object& self,
+                        const py::array_t<int64_t, py::array::c_style | py::array::forcecast>& actions){
+
+                std::vector<int64_t> moves(actions.data(), actions.data() + actions.size());
+
+                {
+                    // the games are stepped on several threads
+                    py::gil_scoped_release release;
+                    self.cast<sente::utils::GoEnvBatch&>().step(moves);
+                }
+
+                return py::make_tuple(sente::utils::getObservations(self), sente::utils::getLegalMasks(self),
+                                      sente::utils::getRewards(self), sente::utils::getDone(self));
+            },
+            py::arg("actions"),
+            R"pbdoc(
+                plays one action in every game. Games that end (by two passes in a row or by reaching the move limit)
+                are scored, marked as done and started over, so their observation is the start of a new game
+
+                :param actions: array with one action for each game
+                :return: tuple of the observations (``(count, board_size, board_size, features)``), the legal move
+                    masks (``(count, board_size * board_size + 1)``), the rewards and the done flags. The reward is
+                    1 if the player who made the action won the game that it ended, -1 if they lost and 0 otherwise
+                :raises IndexError: if an action is not on the board
+                :raises ValueError: if an action is illegal (in which case no action is played)
+            )pbdoc")
+        .def_property_readonly("observations", &sente::utils::getObservations,
+            "read-only view of the observations of the current positions (updated in place by every step)")
+        .def_property_readonly("legal_masks", &sente::utils::getLegalMasks,
+            "read-only view of the legal moves of the current positions (updated in place by every step)")
+        .def_property_readonly("rewards", &sente::utils::getRewards,
+            "read-only view of the rewards of the last step (updated in place by every step)")
+        .def_property_readonly("done", &sente::utils::getDone,
+            "read-only view of which games ended on the last step (updated in place by every step)")
+        .def("get_game", &sente::utils::GoEnvBatch::getGame,
+            py::arg("index"),
+            py::return_value_policy::reference_internal,
+            R"pbdoc(
+                gets one of the games of the batch
+
+                :param index: index of the game
+                :return: the game, which changes with every step
+            )pbdoc")
+        .def("__len__", &sente::utils::GoEnvBatch::getCount);
+
     auto sgf = module.def_submodule("sgf", "utilities for parsing SGF (Smart Game Format) files")
         .def("load", [](const std::string& fileName, bool disableWarnings,
                                                      bool ignoreIllegalProperties,
@@ -788,6 +1505,88 @@ PYBIND11_MODULE(sente, module){
             py::call_guard<py::gil_scoped_release>(),
             "Serialize a string as an SGF");
 
+    py::class_<sente::utils::SGFDataset>(sgf, "Dataset", R"pbdoc(
+            A collection of SGF files turned into training samples.
+
+            The main line of each game is replayed by the rules of the game, and every move gives a sample of the
+            position it was played in. The files are read on several threads without holding the GIL, and the samples
+            are handed out in chunks of ``chunk_size`` (the last chunk may be smaller), so the collection never has to
+            fit in memory. Each chunk is a dictionary of numpy arrays:
+
+            * ``"features"``: the features of each position (see ``Game.numpy``)
+            * ``"moves"``: the move played in each position, ``x * side + y`` (starting from zero) or ``side * side``
+              for a pass
+            * ``"results"``: 1 if the player to move won the game, -1 if they lost and 0 for draws and unknown results
+            * ``"move_numbers"``: the number of moves played before each position
+
+            Files that can't be read, are played on another board size or have an illegal move in their main line are
+            skipped and listed in ``skipped``.
+
+            .. code-block:: python
+
+                >>> dataset = sente.sgf.Dataset(["games/"], chunk_size=4096)
+                >>> for chunk in dataset:
+                ...     train(chunk["features"], chunk["moves"], chunk["results"])
+
+        )pbdoc")
+        .def(py::init<const std::vector<std::string>&, std::vector<std::string>, unsigned, unsigned, unsigned, bool, bool,
+                      bool, uint64_t>(),
+            py::arg("paths"),
+            py::arg("features") = std::vector<std::string>{"black_stones", "white_stones", "empty_points", "ko_points"},
+            py::arg("board_size") = 19,
+            py::arg("chunk_size") = 4096,
+            py::arg("threads") = 0,
+            py::arg("packed") = false,
+            py::arg("channels_first") = false,
+            py::arg("augment") = false,
+            py::arg("seed") = 0,
+            R"pbdoc(
+                creates a dataset from SGF files
+
+                :param paths: SGF files and directories to read. Directories are searched (along with the directories
+                    inside them) for files ending in ``.sgf``
+                :param features: names of the features to take from each position (see ``Game.numpy``)
+                :param board_size: size of the boards to keep, games played on other boards are skipped
+                :param chunk_size: number of samples in each chunk
+                :param threads: number of threads to read the files on (0 uses one thread per core)
+                :param packed: pack the points of each plane of the features into bits (see ``sente.unpack``)
+                :param channels_first: put the planes of the features before the points
+                :param augment: give each position a random rotation or reflection of the board, which is applied to
+                    the move as well
+                :param seed: seed for picking the rotations and reflections, the same seed always gives the same ones
+                :raises FileNotFoundError: if a path does not exist
+                :raises ValueError: if a feature is unknown
+            )pbdoc")
+        .def("__iter__", [](sente::utils::SGFDataset& dataset) -> sente::utils::SGFDataset& {
+                dataset.reset();
+                return dataset;
+            },
+            py::return_value_policy::reference_internal,
+            "starts reading the files from the start")
+        .def("__next__", &sente::utils::getNextChunk,
+            R"pbdoc(
+                reads the next chunk of samples
+
+                :return: dictionary with the arrays ``"features"``, ``"moves"``, ``"results"`` and ``"move_numbers"``
+            )pbdoc")
+        .def("write_shards", &sente::utils::SGFDataset::writeShards,
+            py::arg("directory"),
+            py::arg("prefix") = "shard",
+            py::call_guard<py::gil_scoped_release>(),
+            R"pbdoc(
+                reads every file from the start and saves each chunk as ``.npy`` files that can be opened with
+                ``numpy.load``. Chunk ``i`` is saved to ``<prefix>_<i>_features.npy``, ``<prefix>_<i>_moves.npy``,
+                ``<prefix>_<i>_results.npy`` and ``<prefix>_<i>_move_numbers.npy``, with ``i`` padded to five digits.
+
+                :param directory: directory to save the files in, which is made if it doesn't exist
+                :param prefix: start of the name of each file
+                :return: the number of chunks saved
+            )pbdoc")
+        .def_property_readonly("files", &sente::utils::SGFDataset::getFiles,
+            "the SGF files that the dataset reads, in order")
+        .def_property_readonly("skipped", &sente::utils::getSkippedFiles,
+            "list of ``(file, reason)`` tuples for the files that have been skipped since the dataset was started");
+
     auto exceptions = module.def_submodule("exceptions", "various exceptions used by sente");
 
     py::register_exception<sente::utils::InvalidSGFException>(exceptions, "InvalidSGFException");
@@ -831,6 +1630,19 @@ PYBIND11_MODULE(sente, module){
 
                 :return active: whether or not the GTP Session is active
             )pbdoc")
+            .def_property("search", &sente::GTP::DefaultSession::getSearch,
+                          [](sente::GTP::DefaultSession& session, const py::object& search){
+                              if (search.is_none()){
+                                  session.setSearch(nullptr);
+                              }
+                              else {
+                                  session.setSearch(search.cast<std::shared_ptr<sente::MCTS>>());
+                              }
+                          }, R"pbdoc(
+                    built-in search used to implement ``genmove``. Setting a ``sente.MCTS`` object takes the place of
+                    any function registered with ``GenMove``, so the engine can generate moves without calling python.
+                    Setting the search back to ``None`` goes back to the ``GenMove`` function
+                )pbdoc")
             .def_readwrite("game", &sente::GTP::DefaultSession::masterGame)
             .def_property("name", &sente::GTP::DefaultSession::getEngineName,
                           &sente::GTP::DefaultSession::setEngineName);
@@ -5,9 +5,12 @@ Author: Arthur Wesley
 """
 
 import os
+import tempfile
 from pathlib import Path
 from unittest import TestCase
 
+import numpy as np
+
 import sente.exceptions
 from sente import sgf
 
@@ -621,3 +624,129 @@ class InvalidSGFWarnings(TestCase):
             sgf.load("tests/warning sgf/Jappanese Date (JD) property.sgf", ignore_illegal_properties=False)
         with self.assertRaises(sente.exceptions.InvalidSGFException):
             sgf.load("tests/warning sgf/ParkJaegeun-LeeJihyun72148.sgf", ignore_illegal_properties=False)
+
+
+class Dataset(TestCase):
+
+    def test_samples(self):
+        """
+
+        tests to see if the samples of a game match replaying the game
+
+        :return:
+        """
+
+        file = "tests/sgf/Lee Sedol ladder game.sgf"
+
+        dataset = sgf.Dataset([file], ["black_stones", "white_stones", "ko_points"], chunk_size=100000)
+        chunk = next(iter(dataset))
+
+        game = sgf.load(file)
+        moves = game.get_default_sequence()
+
+        self.assertEqual(len(moves), len(chunk["moves"]))
+
+        for number, move in enumerate(moves):
+            self.assertTrue(np.array_equal(game.numpy(["black_stones", "white_stones", "ko_points"]),
+                                           chunk["features"][number]))
+            self.assertEqual(move.get_x() * 19 + move.get_y(), chunk["moves"][number])
+            self.assertEqual(number, chunk["move_numbers"][number])
+            # black won the game by resignation
+            self.assertEqual(1 if move.get_stone() == sente.stone.BLACK else -1, chunk["results"][number])
+            game.play(move)
+
+        with self.assertRaises(StopIteration):
+            next(dataset)
+
+    def test_chunks(self):
+        """
+
+        tests to see if a directory of games is split into full chunks
+
+        :return:
+        """
+
+        dataset = sgf.Dataset(["tests/sgf"], chunk_size=100, threads=3)
+
+        chunks = list(dataset)
+        everything = next(iter(sgf.Dataset(["tests/sgf"], chunk_size=100000)))
+
+        for chunk in chunks[:-1]:
+            self.assertEqual(100, len(chunk["moves"]))
+        self.assertLessEqual(len(chunks[-1]["moves"]), 100)
+
+        for key in ["features", "moves", "results", "move_numbers"]:
+            self.assertTrue(np.array_equal(everything[key], np.concatenate([chunk[key] for chunk in chunks])))
+
+        # the nine by nine game is left out
+        self.assertIn(os.path.join("tests/sgf", "handyNine.sgf"), [file for file, reason in dataset.skipped])
+        self.assertEqual(sorted(dataset.files), dataset.files)
+
+    def test_augment(self):
+        """
+
+        tests to see if augmented samples are rotations and reflections of the plain samples
+
+        :return:
+        """
+
+        file = "tests/sgf/Lee Sedol ladder game.sgf"
+
+        plain = next(iter(sgf.Dataset([file], ["black_stones", "white_stones"], chunk_size=50)))
+        augmented = next(iter(sgf.Dataset([file], ["black_stones", "white_stones"], chunk_size=50, augment=True,
+                                          seed=4)))
+
+        for index in range(50):
+            move = sente.Move(sente.stone.BLACK, plain["moves"][index] // 19 + 1, plain["moves"][index] % 19 + 1)
+
+            matches = []
+            for symmetry in range(8):
+                features = plain["features"][index]
+                if symmetry & 4:
+                    features = np.swapaxes(features, 0, 1)
+                if symmetry & 1:
+                    features = np.flip(features, 0)
+                if symmetry & 2:
+                    features = np.flip(features, 1)
+
+                target = move.transform(symmetry, 19)
+                matches.append(np.array_equal(features, augmented["features"][index]) and
+                               target.get_x() * 19 + target.get_y() == augmented["moves"][index])
+
+            self.assertTrue(any(matches))
+
+    def test_write_shards(self):
+        """
+
+        tests to see if the dataset can be saved as .npy files
+
+        :return:
+        """
+
+        dataset = sgf.Dataset(["tests/sgf"], chunk_size=256, packed=True)
+
+        with tempfile.TemporaryDirectory() as directory:
+            shards = dataset.write_shards(directory, "train")
+            chunks = list(dataset)
+
+            self.assertEqual(len(chunks), shards)
+
+            for index, chunk in enumerate(chunks):
+                for key in ["features", "moves", "results", "move_numbers"]:
+                    saved = np.load(os.path.join(directory, "train_{:05d}_{}.npy".format(index, key)))
+                    self.assertTrue(np.array_equal(chunk[key], saved))
+
+    def test_errors(self):
+        """
+
+        tests to see if bad arguments raise errors
+
+        :return:
+        """
+
+        with self.assertRaises(FileNotFoundError):
+            sgf.Dataset(["tests/sgf/not a file.sgf"])
+        with self.assertRaises(ValueError):
+            sgf.Dataset(["tests/sgf"], ["not a feature"])
+        with self.assertRaises(ValueError):
+            sgf.Dataset(["tests/sgf"], chunk_size=0)
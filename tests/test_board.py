@@ -6,6 +6,8 @@ Author: Arthur Wesley
 
 from unittest import TestCase
 
+import numpy as np
+
 from sente import *
 
 
@@ -62,6 +64,57 @@ class BoardTest19(TestCase):
         self.assertEqual(board.get_stone(5, 5), stone.EMPTY)
         self.assertEqual(board.get_stone(4, 4), stone.BLACK)
 
+    def test_numpy(self):
+        """
+
+        checks to see if the board can be converted to a numpy array
+
+        :return:
+        """
+
+        board = Board19()
+        board.play(Move(stone.BLACK, 4, 4))
+        board.play(Move(stone.WHITE, 9, 4))
+
+        array = board.numpy()
+
+        self.assertEqual((19, 19), array.shape)
+        self.assertEqual(np.int8, array.dtype)
+        self.assertEqual(1, array[3, 3])
+        self.assertEqual(-1, array[8, 3])
+        self.assertEqual(0, np.sum(np.abs(array)) - 2)
+
+        out = np.zeros((19, 19), dtype=np.float32)
+        self.assertIs(out, board.numpy(out=out))
+        self.assertTrue(np.array_equal(array, out))
+
+        with self.assertRaises(ValueError):
+            board.numpy(dtype=np.uint8)
+        with self.assertRaises(ValueError):
+            board.numpy(out=np.zeros((9, 9), dtype=np.int8))
+
+    def test_numpy_packed(self):
+        """
+
+        checks to see if the board can be packed into bits
+
+        :return:
+        """
+
+        board = Board19()
+        board.play(Move(stone.BLACK, 4, 4))
+        board.play(Move(stone.WHITE, 9, 4))
+
+        packed = board.numpy(packed=True)
+
+        self.assertEqual((2, 46), packed.shape)
+
+        stones = unpack(packed, 19)
+        array = board.numpy()
+
+        self.assertTrue(np.array_equal(array == 1, stones[:, :, 0] == 1))
+        self.assertTrue(np.array_equal(array == -1, stones[:, :, 1] == 1))
+
     def test__str__(self):
         """
 
@@ -27,8 +27,16 @@ class TestBasicMethods(TestCase):
         sente.Game(rules=sente.rules.JAPANESE)
         sente.Game(rules=sente.rules.JAPANESE, board_size=13)
 
+        sente.Game(2)
+        sente.Game(5)
+        sente.Game(15, sente.rules.JAPANESE)
+        sente.Game(25)
+
+        with self.assertRaises(ValueError):
+            sente.Game(1)
+
         with self.assertRaises(ValueError):
-            sente.Game(15, sente.rules.JAPANESE)
+            sente.Game(26, sente.rules.JAPANESE)
 
     def test_play(self):
         """
@@ -102,6 +110,54 @@ class TestBasicMethods(TestCase):
 
         self.assertEqual(83, len(game.get_legal_moves()))
 
+    def test_small_board(self):
+        """
+
+        checks that games can be played and scored on boards smaller than 9x9
+
+        :return:
+        """
+
+        game = sente.Game(5)
+
+        self.assertEqual(27, len(game.get_legal_moves()))
+
+        game.play(1, 2)
+        game.play(1, 1)
+        game.play(2, 1)
+
+        # white's corner stone has been captured
+        self.assertEqual(sente.stone.EMPTY, game.get_point(1, 1))
+
+        with self.assertRaises(sente.exceptions.IllegalMoveException):
+            game.play(6, 6)
+
+        game.pss()
+        game.pss()
+
+        # black surrounds the whole board, which is more than the komi
+        self.assertEqual(sente.stone.BLACK, game.get_winner())
+
+    def test_large_board(self):
+        """
+
+        checks that every point on a board larger than 19x19 can be played on and that passing does not place a stone
+
+        :return:
+        """
+
+        game = sente.Game(25)
+
+        self.assertEqual(627, len(game.get_legal_moves()))
+
+        game.play(25, 25)
+        game.play(20, 20)
+        game.pss()
+
+        self.assertEqual(sente.stone.BLACK, game.get_point(25, 25))
+        self.assertEqual(sente.stone.WHITE, game.get_point(20, 20))
+        self.assertEqual(sente.stone.WHITE, game.get_active_player())
+
     def test_score_empty_game(self):
         """
 
@@ -137,6 +193,43 @@ class TestBasicMethods(TestCase):
         with self.assertRaises(IndexError):
             game.get_point(30, 30)
 
+    def test_get_liberties(self):
+        """
+
+        checks that the liberties of a group follow placements, merges and captures
+
+        :return:
+        """
+
+        game = sente.Game(9)
+
+        game.play(1, 1)
+        self.assertEqual(2, game.count_liberties(1, 1))
+
+        game.play(1, 2)
+        self.assertEqual(1, game.count_liberties(1, 1))
+        self.assertEqual(2, game.count_liberties(1, 2))
+
+        game.play(2, 1)
+        self.assertEqual(2, game.count_liberties(1, 1))
+        self.assertEqual({(2, 0), (1, 1)}, {(move.get_x(), move.get_y()) for move in game.get_liberties(2, 1)})
+
+        game.play(2, 2)
+        game.play(3, 1)
+        game.play(3, 2)
+        game.play(4, 4)
+        game.play(4, 1)
+
+        # white captures black's three stones and gets their points back as liberties
+        self.assertEqual(sente.stone.EMPTY, game.get_point(1, 1))
+        self.assertEqual(7, game.count_liberties(1, 2))
+
+        with self.assertRaises(ValueError):
+            game.get_liberties(1, 1)
+
+        with self.assertRaises(IndexError):
+            game.count_liberties(10, 10)
+
     def test__str__(self):
         """
 
@@ -149,6 +242,72 @@ class TestBasicMethods(TestCase):
 
         self.assertEqual(str(game.get_board()), str(game))
 
+    def test_clone(self):
+        """
+
+        tests to see if a cloned game can be played on without affecting the original
+
+        :return:
+        """
+
+        game = sente.Game()
+        game.play(4, 4)
+
+        clone = game.clone()
+        clone.play(16, 16)
+
+        self.assertEqual(sente.stone.WHITE, clone.get_point(16, 16))
+        self.assertEqual(sente.stone.EMPTY, game.get_point(16, 16))
+        self.assertEqual([], game.get_branches())
+
+        clone.step_up(2)
+        self.assertEqual(sente.stone.EMPTY, clone.get_point(4, 4))
+        self.assertEqual(sente.stone.BLACK, game.get_point(4, 4))
+
+    def test_clone_without_history(self):
+        """
+
+        tests to see if a game cloned without its history starts from the current position
+
+        :return:
+        """
+
+        game = sente.Game()
+        game.play(4, 4)
+
+        clone = game.clone(history=False)
+
+        self.assertEqual(sente.stone.BLACK, clone.get_point(4, 4))
+        self.assertEqual(sente.stone.WHITE, clone.get_active_player())
+        self.assertEqual([], clone.get_sequence())
+        self.assertEqual(game.get_hash(), clone.get_hash())
+
+        clone.play(16, 16)
+        self.assertEqual(sente.stone.EMPTY, game.get_point(16, 16))
+
+    def test_clone_without_history_features(self):
+        """
+
+        tests to see if a game cloned without its history has the same history features as the game
+
+        :return:
+        """
+
+        features = ["history_black", "history_white", "turns_since"]
+
+        game = sente.Game(9)
+        for x, y in [(1, 1), (1, 2), (5, 5), (2, 1), (7, 7)]:
+            game.play(x, y)
+
+        clone = game.clone(history=False)
+
+        self.assertTrue(np.array_equal(game.numpy(features), clone.numpy(features)))
+
+        game.play(8, 8)
+        clone.play(8, 8)
+
+        self.assertTrue(np.array_equal(game.numpy(features), clone.numpy(features)))
+
 
 class TestMetadata(TestCase):
 
@@ -311,6 +470,121 @@ class TestTreeNavigation(TestCase):
         self.assertEqual(sente.stone.EMPTY, game.get_point(15, 3))
         self.assertEqual(sente.stone.EMPTY, game.get_point(15, 15))
 
+    def test_undo_capture(self):
+        """
+
+        tests to see if undoing a capture puts the captured stones back
+
+        :return:
+        """
+
+        game = sente.Game()
+
+        game.play(1, 1)
+        game.play(2, 1)
+        game.play(9, 9)
+
+        before = game.get_hash()
+
+        game.play(1, 2)  # capture the stone in the corner
+
+        self.assertEqual(sente.stone.EMPTY, game.get_point(1, 1))
+
+        game.step_up()
+
+        self.assertEqual(sente.stone.BLACK, game.get_point(1, 1))
+        self.assertEqual(sente.stone.EMPTY, game.get_point(1, 2))
+        self.assertEqual(sente.stone.WHITE, game.get_active_player())
+        self.assertEqual(before, game.get_hash())
+
+        # the capture can be played again
+        game.play(1, 2)
+        self.assertEqual(sente.stone.EMPTY, game.get_point(1, 1))
+
+    def test_end_playout(self):
+        """
+
+        tests to see if ending a playout takes back its moves without changing the game tree
+
+        :return:
+        """
+
+        game = sente.Game()
+
+        game.play(4, 4)
+
+        game.start_playout()
+        self.assertTrue(game.in_playout())
+
+        game.play(16, 16)
+        game.play(16, 4)
+
+        self.assertEqual(sente.stone.WHITE, game.get_point(16, 16))
+        self.assertEqual(1, len(game.get_sequence()))
+
+        game.end_playout()
+
+        self.assertFalse(game.in_playout())
+        self.assertEqual(sente.stone.BLACK, game.get_point(4, 4))
+        self.assertEqual(sente.stone.EMPTY, game.get_point(16, 16))
+        self.assertEqual(sente.stone.EMPTY, game.get_point(16, 4))
+        self.assertEqual(sente.stone.WHITE, game.get_active_player())
+        self.assertEqual([], game.get_branches())
+
+    def test_resign_in_playout(self):
+        """
+
+        tests to see if ending a playout takes back a resignation made during it
+
+        :return:
+        """
+
+        game = sente.Game()
+
+        game.play(4, 4)
+
+        game.start_playout()
+        game.play(16, 16)
+        game.resign()
+
+        self.assertTrue(game.is_over())
+        self.assertEqual("W+R", game.get_result())
+
+        game.end_playout()
+
+        self.assertFalse(game.is_over())
+        with self.assertRaises(ValueError):
+            game.get_result()
+        self.assertNotIn("RE", game.get_properties())
+        self.assertEqual(sente.stone.WHITE, game.get_active_player())
+
+        game.play(16, 16)
+        self.assertEqual(sente.stone.WHITE, game.get_point(16, 16))
+
+    def test_commit_playout(self):
+        """
+
+        tests to see if a committed playout is added to the game tree
+
+        :return:
+        """
+
+        game = sente.Game()
+
+        game.play(4, 4)
+
+        game.start_playout()
+        game.play(16, 16)
+        game.play(16, 4)
+        game.commit_playout()
+
+        self.assertFalse(game.in_playout())
+        self.assertEqual([sente.Move(sente.stone.BLACK, 4, 4), sente.Move(sente.stone.WHITE, 16, 16),
+                          sente.Move(sente.stone.BLACK, 16, 4)], game.get_sequence())
+
+        game.step_up(2)
+        self.assertEqual([sente.Move(sente.stone.WHITE, 16, 16)], game.get_branches())
+
     def test_simple_fork(self):
         """
 
@@ -651,6 +925,24 @@ class TestTreeNavigation(TestCase):
 
         self.assertTrue(game.is_over())
 
+    def test_resign_finished_game(self):
+        """
+
+        checks to see if resigning a game that is already over is reported rather than played
+
+        :return:
+        """
+
+        game = sente.Game()
+
+        game.resign()
+
+        self.assertEqual(sente.move_status.GAME_OVER, game.try_play(sente.moves.Resign(sente.stone.WHITE)))
+        self.assertEqual("W+R", game.get_result())
+
+        with self.assertRaises(sente.exceptions.IllegalMoveException):
+            game.resign()
+
     def test_comment_write(self):
         """
 
@@ -850,94 +1142,747 @@ class TestNumpy(TestCase):
 
         self.assertTrue(np.array_equal(correct_board, numpy))
 
-
-class TestHandicaps(TestCase):
-
-    def test_handicap_1(self):
+    def test_legal_moves(self):
         """
 
-        checks to see if a handicap with 1 stone works
+        tests to see if the legal moves feature and the legal move mask match the legal moves of the game
 
         :return:
         """
 
-        game = sente.Game(handicap=sente.get_handicap_stones(1))
-        self.assertEqual(game.get_point(16, 4), sente.stone.BLACK)
-        self.assertEqual(game.get_active_player(), sente.stone.WHITE)
-
-    def test_handicap_2(self):
-        """
+        game = sente.sgf.load("tests/sgf/Lee Sedol ladder game.sgf")
+        game.play_sequence(game.get_default_sequence()[:95])
 
-        checks to see if a handicap with 2 stones works
+        correct = np.zeros((19, 19), dtype=bool)
 
-        :return:
-        """
+        for move in game.get_legal_moves():
+            if move.get_x() < 19 and move.get_y() < 19:
+                correct[move.get_x()][move.get_y()] = True
 
-        game = sente.Game(handicap=sente.get_handicap_stones(2))
+        legal_numpy = game.numpy(["legal_moves"])
+        mask = game.get_legal_mask()
 
-        self.assertEqual(game.get_point(16, 4), sente.stone.BLACK)
-        self.assertEqual(game.get_point(4, 16), sente.stone.BLACK)
-        self.assertEqual(game.get_active_player(), sente.stone.WHITE)
+        self.assertTrue(np.array_equal(correct, legal_numpy[:, :, 0]))
+        self.assertEqual((19 * 19 + 1,), mask.shape)
+        self.assertTrue(np.array_equal(correct, mask[:-1].reshape(19, 19)))
+        self.assertTrue(mask[-1])
 
-    def test_handicap_3(self):
+    def test_legal_mask_ko(self):
         """
 
-        checks to see if a handicap with 2 stones works
+        tests to see if the legal move mask excludes the ko point and occupied points
 
         :return:
         """
 
-        game = sente.Game(handicap=sente.get_handicap_stones(3))
+        game = sente.Game(9)
 
-        self.assertEqual(game.get_point(16, 4), sente.stone.BLACK)
-        self.assertEqual(game.get_point(4, 16), sente.stone.BLACK)
-        self.assertEqual(game.get_point(16, 16), sente.stone.BLACK)
-        self.assertEqual(game.get_active_player(), sente.stone.WHITE)
+        game.play(2, 2)
+        game.play(2, 1)
 
-    def test_handicap_4(self):
+        game.play(3, 1)
+        game.play(1, 2)
+
+        game.play(1, 1)
+
+        mask = game.get_legal_mask()[:-1].reshape(9, 9)
+
+        self.assertFalse(mask[1, 0])
+        self.assertFalse(mask[0, 0])
+        self.assertEqual(81 - 5, mask.sum())
+
+    def test_legal_mask_read_only(self):
         """
 
-        checks to see if a handicap with 2 stones works
+        tests to see if the legal move mask can't be written to
 
         :return:
         """
 
-        game = sente.Game(handicap=sente.get_handicap_stones(4))
+        game = sente.Game(9)
+        mask = game.get_legal_mask()
 
-        self.assertEqual(game.get_point(4, 4), sente.stone.BLACK)
-        self.assertEqual(game.get_point(16, 4), sente.stone.BLACK)
-        self.assertEqual(game.get_point(4, 16), sente.stone.BLACK)
-        self.assertEqual(game.get_point(16, 16), sente.stone.BLACK)
-        self.assertEqual(game.get_active_player(), sente.stone.WHITE)
+        self.assertFalse(mask.flags.writeable)
 
-    def test_handicap_5(self):
+        with self.assertRaises(ValueError):
+            mask[0] = False
+
+        self.assertTrue(game.get_legal_mask()[0])
+
+    def test_liberty_planes(self):
         """
 
-        checks to see if a handicap with 2 stones works
+        tests to see if the liberty planes mark the liberties of each chain
 
         :return:
         """
 
-        game = sente.Game(handicap=sente.get_handicap_stones(5))
+        game = sente.Game(9)
 
-        self.assertEqual(game.get_point(4, 4), sente.stone.BLACK)
-        self.assertEqual(game.get_point(16, 4), sente.stone.BLACK)
-        self.assertEqual(game.get_point(10, 10), sente.stone.BLACK)
-        self.assertEqual(game.get_point(4, 16), sente.stone.BLACK)
-        self.assertEqual(game.get_point(16, 16), sente.stone.BLACK)
-        self.assertEqual(game.get_active_player(), sente.stone.WHITE)
+        game.play(3, 3)
+        game.play(1, 1)
 
-    def test_handicap_6(self):
+        liberties = game.numpy(["liberties"])
+
+        self.assertEqual((9, 9, 8), liberties.shape)
+
+        # one plane for each count, starting at one liberty
+        self.assertEqual(1, liberties[2, 2, 3])
+        self.assertEqual(1, liberties[2, 2].sum())
+        self.assertEqual(1, liberties[0, 0, 1])
+        self.assertEqual(0, liberties[4, 4].sum())
+
+    def test_move_outcome_planes(self):
         """
 
-        checks to see if a handicap with 2 stones works
+        tests to see if the capture size and self atari planes match what a move would do
 
         :return:
         """
 
-        game = sente.Game(handicap=sente.get_handicap_stones(6))
+        game = sente.Game(9)
+
+        # white stone in atari at (2, 1) with black to play
+        game.play({sente.Move(sente.stone.WHITE, 2, 1), sente.Move(sente.stone.BLACK, 1, 1),
+                   sente.Move(sente.stone.BLACK, 3, 1)})
+        game.set_active_player(sente.stone.BLACK)
+
+        planes = game.numpy(["capture_size", "self_atari_size", "liberties_after_move"])
+
+        self.assertEqual((9, 9, 24), planes.shape)
+
+        # capturing the stone takes one stone, and the captured point becomes a fourth liberty
+        self.assertEqual(1, planes[1, 1, 1])
+        self.assertEqual(0, planes[1, 1, 8:16].sum())
+        self.assertEqual(1, planes[1, 1, 16 + 3])
+
+        # a move with nothing to capture has a capture size of zero
+        self.assertEqual(1, planes[6, 6, 0])
+
+        game = sente.Game(9)
+
+        game.play({sente.Move(sente.stone.WHITE, 1, 3), sente.Move(sente.stone.WHITE, 2, 2)})
+        game.set_active_player(sente.stone.BLACK)
+
+        planes = game.numpy(["self_atari_size"])
+
+        # black playing between the white stones is left with a single liberty
+        self.assertEqual(1, planes[0, 1, 0])
+        self.assertEqual(0, planes[4, 4].sum())
+
+    def test_ladder_planes(self):
+        """
+
+        tests to see if the ladder planes read out a ladder and notice a ladder breaker
+
+        :return:
+        """
+
+        stones = {sente.Move(sente.stone.WHITE, 3, 17), sente.Move(sente.stone.BLACK, 3, 18),
+                  sente.Move(sente.stone.BLACK, 4, 17), sente.Move(sente.stone.BLACK, 2, 16)}
+
+        game = sente.Game()
+        game.play(stones)
+        game.set_active_player(sente.stone.BLACK)
+
+        self.assertEqual(1, game.numpy(["ladder_capture"])[1, 16, 0])
+
+        game.play({sente.Move(sente.stone.BLACK, 2, 17)})
+        game.set_active_player(sente.stone.WHITE)
+
+        self.assertEqual(0, game.numpy(["ladder_escape"])[2, 15, 0])
+
+        # a white stone in the path of the ladder lets white escape
+        game = sente.Game()
+        game.play(stones | {sente.Move(sente.stone.WHITE, 13, 7)})
+        game.set_active_player(sente.stone.BLACK)
+
+        self.assertEqual(0, game.numpy(["ladder_capture"])[1, 16, 0])
+
+    def test_turns_since(self):
+        """
+
+        tests to see if the turns since planes count the moves since each stone was played
+
+        :return:
+        """
+
+        game = sente.Game(9)
+
+        for i in range(1, 10):
+            game.play(i, 1 if i % 2 else 9)
+
+        planes = game.numpy(["turns_since"])
+
+        self.assertEqual((9, 9, 8), planes.shape)
+        self.assertEqual(1, planes[8, 0, 0])
+        self.assertEqual(1, planes[7, 8, 1])
+        self.assertEqual(1, planes[2, 0, 6])
+        # stones played more than seven moves ago share the last plane
+        self.assertEqual(1, planes[1, 8, 7])
+        self.assertEqual(1, planes[0, 0, 7])
+        self.assertEqual(0, planes[4, 4].sum())
+
+    def test_history_planes(self):
+        """
+
+        tests to see if the history planes hold the stones of the last eight positions
+
+        :return:
+        """
+
+        game = sente.Game(9)
+
+        # white captures the black stone in the corner with its third move
+        game.play(1, 1)
+        game.play(1, 2)
+        game.play(5, 5)
+        game.play(2, 1)
+
+        planes = game.numpy(["history_black", "history_white"])
+
+        self.assertEqual((9, 9, 16), planes.shape)
+
+        # the corner stone is captured now, but was there one and two moves ago
+        self.assertEqual(0, planes[0, 0, 0])
+        self.assertEqual(1, planes[0, 0, 1])
+        self.assertEqual(1, planes[0, 0, 2])
+        self.assertEqual(1, planes[1, 0, 8])
+        self.assertEqual(0, planes[1, 0, 9])
+        self.assertEqual(1, planes[4, 4, 1])
+        self.assertEqual(0, planes[4, 4, 3])
+
+        # positions from before the start of the game are empty
+        self.assertEqual(0, planes[:, :, 5:8].sum())
+        self.assertEqual(0, planes[:, :, 13:16].sum())
+
+        game.step_up(1)
+
+        planes = game.numpy(["history_black", "history_white"])
+
+        self.assertEqual(1, planes[0, 0, 0])
+        self.assertEqual(0, planes[1, 0, 8])
+        self.assertEqual(1, planes[0, 1, 9])
+
+    def test_player_history(self):
+        """
+
+        tests to see if the player and opponent history planes follow the player whose turn it is
+
+        :return:
+        """
+
+        game = sente.Game(9)
+
+        game.play(3, 3)
+
+        planes = game.numpy(["history_player", "history_opponent", "history_black"])
+
+        # white is to play, so the black stone belongs to the opponent
+        self.assertEqual(0, planes[2, 2, 0])
+        self.assertEqual(1, planes[2, 2, 8])
+        self.assertEqual(1, planes[2, 2, 16])
+        self.assertEqual(0, planes[2, 2, 17])
+
+    def test_sensibleness(self):
+        """
+
+        tests to see if the sensibleness plane leaves out the eyes of the player to move
+
+        :return:
+        """
+
+        game = sente.Game(9)
+
+        game.play({sente.Move(sente.stone.BLACK, 1, 2), sente.Move(sente.stone.BLACK, 2, 1)})
+        game.set_active_player(sente.stone.BLACK)
+
+        planes = game.numpy(["sensibleness", "legal_moves", "side_to_move"])
+
+        self.assertEqual(0, planes[0, 0, 0])
+        self.assertEqual(1, planes[0, 0, 1])
+        self.assertEqual(1, planes[4, 4, 0])
+        self.assertTrue(np.all(planes[:, :, 2] == 1))
+
+        game.set_active_player(sente.stone.WHITE)
+        planes = game.numpy(["sensibleness", "side_to_move"])
+
+        self.assertEqual(1, planes[4, 4, 0])
+        self.assertTrue(np.all(planes[:, :, 1] == 0))
+
+    def test_unknown_feature(self):
+        """
+
+        tests to see if asking for a feature that doesn't exist raises an error
+
+        :return:
+        """
+
+        game = sente.Game(9)
+
+        with self.assertRaises(ValueError):
+            game.numpy(["not a feature"])
+
+    def test_batch_numpy(self):
+        """
+
+        tests to see if the features of a batch of games match the features of each game
+
+        :return:
+        """
+
+        game = sente.sgf.load("tests/sgf/Lee Sedol ladder game.sgf")
+        sequence = game.get_default_sequence()
+
+        games = []
+        for length in range(0, 100, 3):
+            game = sente.sgf.load("tests/sgf/Lee Sedol ladder game.sgf")
+            game.play_sequence(sequence[:length])
+            games.append(game)
+
+        features = ["black_stones", "white_stones", "ko_points", "legal_moves"]
+        batch = sente.numpy(games, features, threads=4)
+
+        self.assertEqual((len(games), 19, 19, 4), batch.shape)
+        self.assertEqual(np.uint8, batch.dtype)
+
+        for index, game in enumerate(games):
+            self.assertTrue(np.array_equal(game.numpy(features), batch[index]))
+
+    def test_batch_numpy_same_game(self):
+        """
+
+        tests to see if a batch that holds the same game many times can be written by several threads at once
+
+        :return:
+        """
+
+        game = sente.sgf.load("tests/sgf/Lee Sedol ladder game.sgf")
+        game.play_default_sequence()
+
+        features = ["liberties", "liberties_after_move", "capture_size", "self_atari_size", "ladder_capture"]
+        expected = game.numpy(features)
+
+        batch = sente.numpy([game] * 32, features, threads=8)
+
+        for index in range(32):
+            self.assertTrue(np.array_equal(expected, batch[index]))
+
+    def test_batch_numpy_out(self):
+        """
+
+        tests to see if the batch features can be written into an existing array
+
+        :return:
+        """
+
+        games = [sente.Game(9) for _ in range(5)]
+        games[2].play(3, 3)
+
+        out = np.full((5, 9, 9, 4), 7, dtype=np.uint8)
+        result = sente.numpy(games, out=out)
+
+        self.assertIs(out, result)
+        self.assertTrue(np.array_equal(games[2].numpy(), out[2]))
+        self.assertTrue(np.array_equal(games[0].numpy(), out[0]))
+
+    def test_numpy_dtype(self):
+        """
+
+        tests to see if the features can be written as floats
+
+        :return:
+        """
+
+        game = sente.Game(9)
+        game.play(3, 4)
+        game.play(7, 2)
+
+        features = game.numpy(["black_stones", "white_stones", "liberties"])
+
+        for dtype in [np.int8, np.float16, np.float32]:
+            converted = game.numpy(["black_stones", "white_stones", "liberties"], dtype=dtype)
+            self.assertEqual(dtype, converted.dtype)
+            self.assertTrue(np.array_equal(features.astype(dtype), converted))
+
+        with self.assertRaises(ValueError):
+            game.numpy(dtype=np.float64)
+
+    def test_numpy_channels_first(self):
+        """
+
+        tests to see if the planes can come before the points
+
+        :return:
+        """
+
+        game = sente.Game(9)
+        game.play(3, 4)
+        game.play(7, 2)
+
+        channels_first = game.numpy(["black_stones", "white_stones", "history_player"], channels_first=True)
+
+        self.assertEqual((10, 9, 9), channels_first.shape)
+        self.assertTrue(np.array_equal(np.moveaxis(game.numpy(["black_stones", "white_stones", "history_player"]),
+                                                   2, 0), channels_first))
+
+        batch = sente.numpy([game, game], ["black_stones"], dtype=np.float32, channels_first=True)
+        self.assertEqual((2, 1, 9, 9), batch.shape)
+        self.assertEqual(1.0, batch[1, 0, 2, 3])
+
+    def test_numpy_out(self):
+        """
+
+        tests to see if the features of one game can be written into an existing array
+
+        :return:
+        """
+
+        game = sente.Game(9)
+        game.play(3, 4)
+
+        out = np.full((4, 9, 9), 7, dtype=np.float32)
+        result = game.numpy(out=out, channels_first=True)
+
+        self.assertIs(out, result)
+        self.assertTrue(np.array_equal(np.moveaxis(game.numpy(), 2, 0), out))
+
+        with self.assertRaises(ValueError):
+            game.numpy(out=np.zeros((9, 9, 4), dtype=np.float32), channels_first=True)
+        with self.assertRaises(ValueError):
+            game.numpy(out=np.zeros((9, 9, 4), dtype=np.float32), dtype=np.uint8)
+        with self.assertRaises(ValueError):
+            game.numpy(out=np.zeros((9, 9, 8), dtype=np.uint8)[:, :, ::2])
+
+    def test_numpy_packed(self):
+        """
+
+        tests to see if packed features match numpy.packbits
+
+        :return:
+        """
+
+        game = sente.Game(19)
+        game.play(3, 4)
+        game.play(7, 2)
+
+        features = game.numpy(["black_stones", "white_stones", "liberties"], channels_first=True)
+        packed = game.numpy(["black_stones", "white_stones", "liberties"], packed=True)
+
+        self.assertEqual((10, 46), packed.shape)
+        self.assertEqual(np.uint8, packed.dtype)
+        self.assertTrue(np.array_equal(np.packbits(features.reshape(10, -1), axis=-1), packed))
+
+        batch = sente.numpy([game, sente.Game(19)], ["black_stones", "white_stones", "liberties"], packed=True)
+        self.assertEqual((2, 10, 46), batch.shape)
+        self.assertTrue(np.array_equal(packed, batch[0]))
+
+        with self.assertRaises(ValueError):
+            game.numpy(packed=True, dtype=np.float32)
+
+    def test_unpack(self):
+        """
+
+        tests to see if packed features can be unpacked
+
+        :return:
+        """
+
+        games = [sente.Game(9) for _ in range(3)]
+        games[1].play(3, 4)
+        games[2].play(7, 2)
+
+        features = sente.numpy(games, ["black_stones", "white_stones", "history_player"])
+        packed = sente.numpy(games, ["black_stones", "white_stones", "history_player"], packed=True)
+
+        self.assertTrue(np.array_equal(features, sente.unpack(packed, 9)))
+        self.assertTrue(np.array_equal(np.moveaxis(features, 3, 1).astype(np.float32),
+                                       sente.unpack(packed, 9, dtype=np.float32, channels_first=True)))
+        self.assertTrue(np.array_equal(features[1], sente.unpack(packed[1], 9)))
+
+        out = np.zeros((3, 10, 9, 9), dtype=np.float16)
+        self.assertIs(out, sente.unpack(packed, 9, out=out, channels_first=True))
+        self.assertTrue(np.array_equal(np.moveaxis(features, 3, 1), out))
+
+        with self.assertRaises(ValueError):
+            sente.unpack(packed, 13)
+        with self.assertRaises(ValueError):
+            sente.unpack(packed.astype(np.int32), 9)
+
+    def test_batch_numpy_errors(self):
+        """
+
+        tests to see if bad batches and output arrays raise errors
+
+        :return:
+        """
+
+        games = [sente.Game(9) for _ in range(3)]
+
+        with self.assertRaises(ValueError):
+            sente.numpy([])
+        with self.assertRaises(ValueError):
+            sente.numpy(games + [sente.Game(13)])
+        with self.assertRaises(ValueError):
+            sente.numpy(games, ["not a feature"])
+        with self.assertRaises(ValueError):
+            sente.numpy(games, out=np.zeros((3, 9, 9, 3), dtype=np.uint8))
+        with self.assertRaises(ValueError):
+            sente.numpy(games, out=np.zeros((3, 9, 9, 4), dtype=np.float64))
+        with self.assertRaises(ValueError):
+            sente.numpy(games, out=np.zeros((3, 9, 9, 8), dtype=np.uint8)[:, :, :, ::2])
+
+    @staticmethod
+    def transform(array, symmetry):
+        """
+
+        rotates and reflects an array of features with numpy
+
+        :param array: array with the board on its first two axes
+        :param symmetry: index of the symmetry to apply
+        :return: transformed array
+        """
+
+        if symmetry & 4:
+            array = np.swapaxes(array, 0, 1)
+        if symmetry & 1:
+            array = np.flip(array, 0)
+        if symmetry & 2:
+            array = np.flip(array, 1)
+
+        return array
+
+    def test_symmetry(self):
+        """
+
+        tests to see if the features of a symmetry match rotating and reflecting the features with numpy
+
+        :return:
+        """
+
+        game = sente.Game(9)
+        game.play(3, 4)
+        game.play(7, 2)
+        game.play(1, 1)
+
+        features = ["black_stones", "white_stones", "liberties", "history_player"]
+        features_array = game.numpy(features)
+
+        for symmetry in range(8):
+            self.assertTrue(np.array_equal(self.transform(features_array, symmetry),
+                                           game.numpy(features, symmetry=symmetry)))
+            self.assertTrue(np.array_equal(self.transform(game.numpy(), symmetry), game.numpy(symmetry=symmetry)))
+
+        with self.assertRaises(ValueError):
+            game.numpy(features, symmetry=8)
+
+    def test_symmetry_legal_mask(self):
+        """
+
+        tests to see if the legal move mask can be transformed
+
+        :return:
+        """
+
+        game = sente.Game(9)
+        game.play(3, 4)
+        game.play(7, 2)
+
+        mask = game.get_legal_mask().copy()
+
+        for symmetry in range(8):
+            transformed = game.get_legal_mask(symmetry=symmetry)
+            self.assertTrue(np.array_equal(self.transform(mask[:-1].reshape(9, 9), symmetry),
+                                           transformed[:-1].reshape(9, 9)))
+            self.assertEqual(mask[-1], transformed[-1])
+
+    def test_symmetry_targets(self):
+        """
+
+        tests to see if a transformed move lands on the same point as the transformed stones
+
+        :return:
+        """
+
+        game = sente.Game(9)
+        move = sente.Move(sente.stone.BLACK, 2, 6)
+        game.play(move)
+
+        for symmetry in range(8):
+            transformed = move.transform(symmetry, 9)
+            stones = game.numpy(["black_stones"], symmetry=symmetry)
+            self.assertEqual(1, stones[transformed.get_x(), transformed.get_y(), 0])
+            self.assertEqual(1, np.sum(stones))
+
+    def test_batch_symmetries(self):
+        """
+
+        tests to see if each game of a batch can be given its own symmetry
+
+        :return:
+        """
+
+        games = [sente.Game(9) for _ in range(8)]
+        for game in games:
+            game.play(3, 4)
+            game.play(7, 2)
+
+        batch = sente.numpy(games, symmetries=list(range(8)))
+
+        for symmetry, game in enumerate(games):
+            self.assertTrue(np.array_equal(game.numpy(symmetry=symmetry), batch[symmetry]))
+
+        with self.assertRaises(ValueError):
+            sente.numpy(games, symmetries=[1, 2])
+        with self.assertRaises(ValueError):
+            sente.numpy(games, symmetries=[8] * 8)
+
+
+
+class TestPlayouts(TestCase):
+
+    def test_playout_totals(self):
+        """
+
+        tests to see if the playout totals add up
+
+        :return:
+        """
+
+        game = sente.Game(9)
+        game.play(5, 5)
+
+        results = game.run_playouts(50, threads=4, seed=3)
+
+        self.assertEqual(50, results["playouts"])
+        self.assertLessEqual(results[sente.stone.BLACK] + results[sente.stone.WHITE], 50)
+
+        self.assertEqual((9, 9), results["black_ownership"].shape)
+        self.assertEqual((9, 9), results["white_ownership"].shape)
+        self.assertTrue(np.all(results["black_ownership"] + results["white_ownership"] <= 50))
+
+    def test_playouts_deterministic(self):
+        """
+
+        tests to see if playouts with the same seed and number of threads give the same results
+
+        :return:
+        """
+
+        game = sente.Game(9)
+
+        first = game.run_playouts(20, threads=2, seed=7)
+        second = game.run_playouts(20, threads=2, seed=7)
+
+        self.assertEqual(first[sente.stone.BLACK], second[sente.stone.BLACK])
+        self.assertTrue(np.array_equal(first["black_ownership"], second["black_ownership"]))
+
+    def test_playouts_do_not_change_game(self):
+        """
+
+        tests to see if running playouts leaves the game where it was
+
+        :return:
+        """
+
+        game = sente.Game(9)
+        game.play(3, 3)
+        game.play(4, 4)
+
+        game.run_playouts(10)
+
+        self.assertEqual(2, len(game.get_sequence()))
+        self.assertEqual(sente.stone.BLACK, game.get_active_player())
+        self.assertEqual(sente.stone.BLACK, game.get_point(3, 3))
+
+
+class TestHandicaps(TestCase):
+
+    def test_handicap_1(self):
+        """
+
+        checks to see if a handicap with 1 stone works
+
+        :return:
+        """
+
+        game = sente.Game(handicap=sente.get_handicap_stones(1))
+        self.assertEqual(game.get_point(16, 4), sente.stone.BLACK)
+        self.assertEqual(game.get_active_player(), sente.stone.WHITE)
+
+    def test_handicap_2(self):
+        """
+
+        checks to see if a handicap with 2 stones works
+
+        :return:
+        """
+
+        game = sente.Game(handicap=sente.get_handicap_stones(2))
 
-        self.assertEqual(game.get_point(4, 4), sente.stone.BLACK)
+        self.assertEqual(game.get_point(16, 4), sente.stone.BLACK)
+        self.assertEqual(game.get_point(4, 16), sente.stone.BLACK)
+        self.assertEqual(game.get_active_player(), sente.stone.WHITE)
+
+    def test_handicap_3(self):
+        """
+
+        checks to see if a handicap with 2 stones works
+
+        :return:
+        """
+
+        game = sente.Game(handicap=sente.get_handicap_stones(3))
+
+        self.assertEqual(game.get_point(16, 4), sente.stone.BLACK)
+        self.assertEqual(game.get_point(4, 16), sente.stone.BLACK)
+        self.assertEqual(game.get_point(16, 16), sente.stone.BLACK)
+        self.assertEqual(game.get_active_player(), sente.stone.WHITE)
+
+    def test_handicap_4(self):
+        """
+
+        checks to see if a handicap with 2 stones works
+
+        :return:
+        """
+
+        game = sente.Game(handicap=sente.get_handicap_stones(4))
+
+        self.assertEqual(game.get_point(4, 4), sente.stone.BLACK)
+        self.assertEqual(game.get_point(16, 4), sente.stone.BLACK)
+        self.assertEqual(game.get_point(4, 16), sente.stone.BLACK)
+        self.assertEqual(game.get_point(16, 16), sente.stone.BLACK)
+        self.assertEqual(game.get_active_player(), sente.stone.WHITE)
+
+    def test_handicap_5(self):
+        """
+
+        checks to see if a handicap with 2 stones works
+
+        :return:
+        """
+
+        game = sente.Game(handicap=sente.get_handicap_stones(5))
+
+        self.assertEqual(game.get_point(4, 4), sente.stone.BLACK)
+        self.assertEqual(game.get_point(16, 4), sente.stone.BLACK)
+        self.assertEqual(game.get_point(10, 10), sente.stone.BLACK)
+        self.assertEqual(game.get_point(4, 16), sente.stone.BLACK)
+        self.assertEqual(game.get_point(16, 16), sente.stone.BLACK)
+        self.assertEqual(game.get_active_player(), sente.stone.WHITE)
+
+    def test_handicap_6(self):
+        """
+
+        checks to see if a handicap with 2 stones works
+
+        :return:
+        """
+
+        game = sente.Game(handicap=sente.get_handicap_stones(6))
+
+        self.assertEqual(game.get_point(4, 4), sente.stone.BLACK)
         self.assertEqual(game.get_point(16, 4), sente.stone.BLACK)
         self.assertEqual(game.get_point(4, 16), sente.stone.BLACK)
         self.assertEqual(game.get_point(16, 16), sente.stone.BLACK)
@@ -1165,3 +2110,104 @@ class TestSetSpaces(TestCase):
         self.assertIn(sente.Move(sente.BLACK, 4, 16), game.get_branches()[0])
         self.assertIn(sente.Move(sente.WHITE, 16, 4), game.get_branches()[0])
         self.assertIn(sente.Move(sente.WHITE, 4, 4), game.get_branches()[0])
+
+
+class TestGoEnvBatch(TestCase):
+
+    def test_reset(self):
+        """
+
+        tests to see if the batch starts with empty boards
+
+        :return:
+        """
+
+        env = sente.GoEnvBatch(4, board_size=9)
+        observations, legal = env.reset()
+
+        self.assertEqual((4, 9, 9, 4), observations.shape)
+        self.assertEqual((4, 82), legal.shape)
+        self.assertTrue(np.all(observations[:, :, :, 2] == 1))
+        self.assertTrue(np.all(legal))
+
+    def test_step(self):
+        """
+
+        tests to see if stepping plays one move in each game
+
+        :return:
+        """
+
+        env = sente.GoEnvBatch(3, board_size=9, threads=2)
+        env.reset()
+
+        observations, legal, rewards, done = env.step(np.array([0, 10, 81]))
+
+        self.assertEqual(1, observations[0, 0, 0, 0])
+        self.assertEqual(1, observations[1, 1, 1, 0])
+        self.assertEqual(0, observations[2, :, :, 0].sum())
+        self.assertFalse(legal[0, 0])
+        self.assertFalse(np.any(done))
+        self.assertTrue(np.all(rewards == 0))
+
+    def test_finished_games_reset(self):
+        """
+
+        tests to see if games that end are scored and started over
+
+        :return:
+        """
+
+        env = sente.GoEnvBatch(2, board_size=5, komi=0.5)
+        env.reset()
+
+        env.step(np.array([12, 0]))
+        env.step(np.array([25, 1]))
+        observations, legal, rewards, done = env.step(np.array([25, 2]))
+
+        # black ended the first game with a stone in the center and wins it
+        self.assertEqual([True, False], list(done))
+        self.assertEqual([1, 0], list(rewards))
+        self.assertEqual(0, observations[0, :, :, 0].sum())
+        self.assertEqual(1, observations[1, 0, 0, 0])
+        self.assertEqual(1, observations[1, 0, 1, 1])
+
+    def test_illegal_action(self):
+        """
+
+        tests to see if an illegal action raises an error without playing any moves
+
+        :return:
+        """
+
+        env = sente.GoEnvBatch(2, board_size=9)
+        env.reset()
+        env.step(np.array([0, 1]))
+
+        with self.assertRaises(ValueError):
+            env.step(np.array([5, 1]))
+
+        with self.assertRaises(IndexError):
+            env.step(np.array([5, 82]))
+
+        self.assertEqual(0, env.observations[0, 0, 5, :2].sum())
+
+    def test_views_read_only(self):
+        """
+
+        tests to see if the arrays of the batch can't be written to, so an action can't be made legal from python
+
+        :return:
+        """
+
+        env = sente.GoEnvBatch(2, board_size=9)
+        env.reset()
+        env.step(np.array([0, 1]))
+
+        for array in [env.observations, env.legal_masks, env.rewards, env.done]:
+            self.assertFalse(array.flags.writeable)
+            with self.assertRaises(ValueError):
+                array[0] = 1
+
+        with self.assertRaises(ValueError):
+            env.step(np.array([0, 2]))
@@ -0,0 +1,432 @@
+"""
+
+Author: Arthur Wesley
+
+"""
+
+import threading
+from unittest import TestCase
+
+import numpy as np
+
+import sente
+from sente import GTP
+
+
+class TestSearch(TestCase):
+
+    def test_search_returns_legal_move(self):
+        """
+
+        tests to see if the search returns a legal move for the active player
+
+        :return:
+        """
+
+        game = sente.Game(9)
+        game.play(5, 5)
+
+        search = sente.MCTS(playouts=200, threads=2)
+        move = search.search(game)
+
+        self.assertEqual(sente.stone.WHITE, move.get_stone())
+        self.assertTrue(game.is_legal(move))
+        self.assertEqual(1, len(game.get_sequence()))
+
+    def test_visits(self):
+        """
+
+        tests to see if the visits of the moves add up to the number of playouts
+
+        :return:
+        """
+
+        game = sente.Game(9)
+
+        search = sente.MCTS(playouts=300, threads=4, batch_size=4)
+        search.search(game)
+
+        self.assertEqual(300, search.get_root_visits())
+        # the first visit expands the root
+        self.assertEqual(299, sum(search.get_visits().values()))
+        self.assertLessEqual(abs(search.get_value()), 1)
+
+    def test_deterministic(self):
+        """
+
+        tests to see if a single threaded search with the same seed picks the same move
+
+        :return:
+        """
+
+        game = sente.Game(9)
+
+        first = sente.MCTS(playouts=200, seed=4).search(game)
+        second = sente.MCTS(playouts=200, seed=4).search(game)
+
+        self.assertEqual(first, second)
+
+    def test_tree_reuse(self):
+        """
+
+        tests to see if searching after two moves reuses the tree of the last search
+
+        :return:
+        """
+
+        game = sente.Game(9)
+
+        search = sente.MCTS(playouts=500)
+
+        game.play(search.search(game))
+        reply = search.search(game)
+        visits = search.get_visits()[reply]
+        game.play(reply)
+
+        search.search(game)
+
+        self.assertEqual(visits + 500, search.get_root_visits())
+
+    def test_tree_reuse_ko(self):
+        """
+
+        tests to see if the tree of a position is not reused for the same stones with a ko point
+
+        :return:
+        """
+
+        # the stones of the ko below with white to play, but without a ko to stop white from taking back
+        setup = sente.sgf.loads("(;SZ[9]AB[bc][cb][dc][ii][cd]AW[bd][dd][ce]PL[W])")
+
+        game = sente.Game(9)
+        for x, y in [(2, 3), (2, 4), (3, 2), (4, 4), (4, 3), (3, 5), (9, 9), (3, 3), (3, 4)]:
+            game.play(x, y)
+
+        self.assertEqual(game.get_hash(), setup.get_hash())
+
+        search = sente.MCTS(playouts=300)
+        search.search(setup)
+        move = search.search(game)
+
+        self.assertEqual(300, search.get_root_visits())
+        self.assertNotIn(sente.Move(sente.stone.WHITE, 3, 3), search.get_visits())
+        self.assertTrue(game.is_legal(move))
+
+    def test_clear(self):
+        """
+
+        tests to see if clearing the search throws away the tree
+
+        :return:
+        """
+
+        game = sente.Game(9)
+
+        search = sente.MCTS(playouts=100)
+        search.search(game)
+        search.clear()
+
+        self.assertEqual(0, search.get_root_visits())
+
+
+class TestEvaluator(TestCase):
+
+    def test_evaluator_batches(self):
+        """
+
+        tests to see if the evaluator is called with batches of features
+
+        :return:
+        """
+
+        shapes = []
+
+        def evaluate(features):
+            shapes.append(features.shape)
+            batch = features.shape[0]
+            return np.full((batch, 9 * 9 + 1), 1 / 82), np.zeros(batch)
+
+        game = sente.Game(9)
+
+        search = sente.MCTS(playouts=64, threads=2, batch_size=8, evaluator=evaluate,
+                            features=["black_stones", "white_stones"])
+        search.search(game)
+
+        self.assertTrue(shapes)
+        for shape in shapes:
+            self.assertEqual((9, 9, 2), shape[1:])
+            self.assertLessEqual(shape[0], 8)
+
+    def test_evaluator_history(self):
+        """
+
+        tests to see if the evaluator sees the moves played before the position being searched
+
+        :return:
+        """
+
+        features = ["history_black", "history_white", "turns_since"]
+        batches = []
+
+        def evaluate(array):
+            batches.append(array.copy())
+            batch = array.shape[0]
+            return np.full((batch, 9 * 9 + 1), 1 / 82), np.zeros(batch)
+
+        game = sente.Game(9)
+        for x, y in [(1, 1), (1, 2), (5, 5), (2, 1), (7, 7)]:
+            game.play(x, y)
+
+        search = sente.MCTS(playouts=1, evaluator=evaluate, features=features)
+        search.search(game)
+
+        # the only evaluation is of the position being searched
+        self.assertEqual(1, len(batches))
+        self.assertTrue(np.array_equal(game.numpy(features), batches[0][0]))
+        self.assertEqual(1, batches[0][0][0, 0, 2])
+
+    def test_policy_guides_search(self):
+        """
+
+        tests to see if the PUCT search follows the policy of the evaluator
+
+        :return:
+        """
+
+        def evaluate(features):
+            batch = features.shape[0]
+            policy = np.zeros((batch, 9 * 9 + 1))
+            policy[:, 2 * 9 + 6] = 1
+            return policy, np.zeros(batch)
+
+        game = sente.Game(9)
+
+        search = sente.MCTS(playouts=50, selection=sente.selection_rule.PUCT, evaluator=evaluate)
+
+        self.assertEqual(sente.Move(sente.stone.BLACK, 3, 7), search.search(game))
+
+    def test_invalid_policy(self):
+        """
+
+        tests to see if an evaluator that returns the wrong shape raises a ValueError
+
+        :return:
+        """
+
+        def evaluate(features):
+            return np.zeros((features.shape[0], 3)), np.zeros(features.shape[0])
+
+        game = sente.Game(9)
+
+        search = sente.MCTS(playouts=10, evaluator=evaluate)
+
+        with self.assertRaises(ValueError):
+            search.search(game)
+
+
+class TestGTPSearch(TestCase):
+
+    def test_genmove(self):
+        """
+
+        tests to see if genmove uses the built-in search
+
+        :return:
+        """
+
+        session = GTP.Session()
+        session.search = sente.MCTS(playouts=100)
+
+        response = session.interpret("genmove B")
+
+        self.assertTrue(response.startswith("= "))
+        self.assertEqual(1, len(session.game.get_sequence()))
+        self.assertEqual(sente.stone.WHITE, session.game.get_active_player())
+
+    def test_search_replaces_gen_move(self):
+        """
+
+        tests to see if setting the search replaces a registered genmove function
+
+        :return:
+        """
+
+        session = GTP.Session()
+
+        called = []
+
+        @session.GenMove
+        def gen_move(color: sente.stone) -> sente.Move:
+            called.append(color)
+            return sente.moves.Pass(color)
+
+        session.search = sente.MCTS(playouts=100)
+        session.interpret("boardsize 9")
+
+        response = session.interpret("genmove W")
+
+        self.assertTrue(response.startswith("= "))
+        self.assertFalse(called)
+        self.assertEqual(sente.stone.WHITE, session.game.get_sequence()[0].get_stone())
+
+    def test_removing_search_restores_gen_move(self):
+        """
+
+        tests to see if setting the search back to None goes back to the registered genmove function
+
+        :return:
+        """
+
+        session = GTP.Session()
+
+        called = []
+
+        @session.GenMove
+        def gen_move(color: sente.stone) -> sente.Move:
+            called.append(color)
+            return sente.moves.Pass(color)
+
+        session.search = sente.MCTS(playouts=10)
+        session.search = sente.MCTS(playouts=10)
+        session.search = None
+
+        response = session.interpret("genmove B")
+
+        self.assertTrue(response.startswith("= "))
+        self.assertEqual([sente.stone.BLACK], called)
+
+    def test_genmove_keeps_player(self):
+        """
+
+        tests to see if genmove for the player to move does not set the player in the game tree
+
+        :return:
+        """
+
+        session = GTP.Session()
+        session.search = sente.MCTS(playouts=10)
+        session.interpret("boardsize 9")
+
+        session.interpret("genmove B")
+
+        self.assertNotIn("PL", session.game.get_properties())
+
+
+class TestEvaluationQueue(TestCase):
+
+    @staticmethod
+    def uniform(calls):
+        """
+
+        creates an evaluator that records the size of each batch
+
+        :param calls: list to record the batch sizes in
+        :return: evaluator function
+        """
+
+        def evaluate(features):
+            calls.append(features.shape[0])
+            batch, side = features.shape[:2]
+            return np.full((batch, side * side + 1), 1 / (side * side + 1)), np.zeros(batch)
+
+        return evaluate
+
+    def test_evaluate(self):
+        """
+
+        tests to see if evaluating a list of games calls the function once
+
+        :return:
+        """
+
+        calls = []
+        queue = sente.EvaluationQueue(self.uniform(calls))
+
+        policy, value = queue.evaluate([sente.Game(9), sente.Game(9), sente.Game(9)])
+
+        self.assertEqual((3, 82), policy.shape)
+        self.assertEqual((3,), value.shape)
+        self.assertEqual([3], calls)
+        self.assertEqual(1, queue.batches)
+        self.assertEqual(3, queue.positions)
+
+    def test_threads_share_batches(self):
+        """
+
+        tests to see if positions from different threads are evaluated in the same batch
+
+        :return:
+        """
+
+        calls = []
+        queue = sente.EvaluationQueue(self.uniform(calls), max_batch_size=8, max_delay=1)
+
+        threads = [threading.Thread(target=queue.evaluate, args=([sente.Game(9)],)) for _ in range(8)]
+
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+
+        self.assertEqual(8, sum(calls))
+        self.assertLess(len(calls), 8)
+
+    def test_searches_share_queue(self):
+        """
+
+        tests to see if several searches can use the same queue
+
+        :return:
+        """
+
+        calls = []
+        queue = sente.EvaluationQueue(self.uniform(calls), max_batch_size=16, max_delay=0.01)
+
+        searches = [sente.MCTS(playouts=50, threads=2, evaluator=queue) for _ in range(4)]
+        games = [sente.Game(9) for _ in range(4)]
+
+        threads = [threading.Thread(target=search.search, args=(game,)) for search, game in zip(searches, games)]
+
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+
+        self.assertEqual(200, queue.positions)
+        self.assertLessEqual(max(calls), 16)
+        for search in searches:
+            self.assertEqual(50, search.get_root_visits())
+
+    def test_errors_reach_caller(self):
+        """
+
+        tests to see if an exception raised by the function is raised by evaluate
+
+        :return:
+        """
+
+        def evaluate(features):
+            raise ValueError("bad network")
+
+        queue = sente.EvaluationQueue(evaluate)
+
+        with self.assertRaises(ValueError):
+            queue.evaluate([sente.Game(9)])
+
+    def test_mixed_board_sizes(self):
+        """
+
+        tests to see if evaluating games on different board sizes at once raises a ValueError
+
+        :return:
+        """
+
+        calls = []
+        queue = sente.EvaluationQueue(self.uniform(calls))
+
+        with self.assertRaises(ValueError):
+            queue.evaluate([sente.Game(9), sente.Game(19)])
+        with self.assertRaises(ValueError):
+            queue.evaluate([sente.Game(9), None])
+
+        self.assertEqual([], calls)
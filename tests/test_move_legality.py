@@ -101,6 +101,60 @@ class TestMove(TestCase):
         self.assertEqual(sente.stone.EMPTY, game.get_point(1, 2))
         self.assertEqual(sente.stone.EMPTY, game.get_point(2, 1))
 
+    def test_tromp_taylor_group_self_capture(self):
+        """
+
+        checks to see if a self-capture under Tromp-Taylor rules removes the entire group
+
+        :return:
+        """
+
+        game = sente.Game(9, sente.rules.TROMP_TAYLOR)
+
+        game.play(1, 2, sente.stone.BLACK)
+        game.play(1, 1, sente.stone.WHITE)
+
+        game.play(2, 2, sente.stone.BLACK)
+        game.play(9, 9, sente.stone.WHITE)
+
+        game.play(3, 1, sente.stone.BLACK)
+        game.play(2, 1, sente.stone.WHITE)
+
+        self.assertEqual(sente.stone.EMPTY, game.get_point(1, 1))
+        self.assertEqual(sente.stone.EMPTY, game.get_point(2, 1))
+        self.assertEqual(sente.stone.BLACK, game.get_point(1, 2))
+        self.assertEqual(sente.stone.BLACK, game.get_point(3, 1))
+
+    def test_capture_merged_group(self):
+        """
+
+        checks to see if two groups that are joined by a stone are captured together
+
+        :return:
+        """
+
+        game = sente.Game(9)
+
+        game.play(1, 1, sente.stone.BLACK)
+        game.play(2, 1, sente.stone.WHITE)
+
+        game.play(1, 3, sente.stone.BLACK)
+        game.play(2, 2, sente.stone.WHITE)
+
+        # connect the two black stones
+        game.play(1, 2, sente.stone.BLACK)
+        game.play(2, 3, sente.stone.WHITE)
+
+        game.play(9, 9, sente.stone.BLACK)
+        game.play(1, 4, sente.stone.WHITE)
+
+        self.assertEqual(sente.stone.EMPTY, game.get_point(1, 1))
+        self.assertEqual(sente.stone.EMPTY, game.get_point(1, 2))
+        self.assertEqual(sente.stone.EMPTY, game.get_point(1, 3))
+
+        # the captured points are liberties again
+        self.assertTrue(game.is_legal(1, 2))
+
     def test_capture_edge(self):
         """
 
@@ -619,6 +673,86 @@ class IllegalMoveThrowsException(TestCase):
         with self.assertRaises(sente.exceptions.IllegalMoveException):
             game.play(4, 4, sente.stone.WHITE)
 
+    @staticmethod
+    def play_triple_ko(game):
+        """
+
+        sets up three kos and plays five moves of the cycle between them, after which black can recreate the position
+        from before the cycle by playing at (14, 3)
+
+        :param game: game to play on
+        :return: hash of the position before the cycle
+        """
+
+        for offset in [0, 6, 12]:
+            game.play(3 + offset, 2, sente.stone.BLACK)
+            game.play(2 + offset, 2, sente.stone.WHITE)
+
+            game.play(3 + offset, 4, sente.stone.BLACK)
+            game.play(2 + offset, 4, sente.stone.WHITE)
+
+            game.play(4 + offset, 3, sente.stone.BLACK)
+            game.play(1 + offset, 3, sente.stone.WHITE)
+
+        game.play(2, 3, sente.stone.BLACK)
+        game.play(9, 3, sente.stone.WHITE)
+        game.play(14, 3, sente.stone.BLACK)
+
+        start = game.get_hash()
+
+        game.play(3, 3, sente.stone.WHITE)
+        game.play(8, 3, sente.stone.BLACK)
+        game.play(15, 3, sente.stone.WHITE)
+        game.play(2, 3, sente.stone.BLACK)
+        game.play(9, 3, sente.stone.WHITE)
+
+        return start
+
+    def test_triple_ko_simple_ko(self):
+        """
+
+        checks that a triple ko can repeat the board position under the simple ko rule
+
+        :return:
+        """
+
+        game = sente.Game(ko_rule=sente.ko_rule.SIMPLE_KO)
+        start = self.play_triple_ko(game)
+
+        game.play(14, 3, sente.stone.BLACK)
+
+        self.assertEqual(start, game.get_hash())
+
+    def test_triple_ko_superko(self):
+        """
+
+        checks that positional and situational superko forbid the move that repeats the position of a triple ko
+
+        :return:
+        """
+
+        for ko_rule in [sente.ko_rule.POSITIONAL_SUPERKO, sente.ko_rule.SITUATIONAL_SUPERKO]:
+            with self.subTest(ko_rule=ko_rule):
+                game = sente.Game(ko_rule=ko_rule)
+                self.play_triple_ko(game)
+
+                self.assertFalse(game.is_legal(14, 3))
+                with self.assertRaises(sente.exceptions.IllegalMoveException):
+                    game.play(14, 3, sente.stone.BLACK)
+
+    def test_superko_requires_area_scoring(self):
+        """
+
+        checks that superko cannot be combined with Japanese or Korean rules
+
+        :return:
+        """
+
+        for rules in [sente.rules.JAPANESE, sente.rules.KOREAN]:
+            with self.subTest(rules=rules):
+                with self.assertRaises(ValueError):
+                    sente.Game(rules=rules, ko_rule=sente.ko_rule.POSITIONAL_SUPERKO)
+
     def test_zero_zero_illegal(self):
         """
         
@@ -631,3 +765,122 @@ class IllegalMoveThrowsException(TestCase):
 
         with self.assertRaises(sente.exceptions.IllegalMoveException):
             game.play(0, 0)
+
+
+class TestTryPlay(TestCase):
+
+    def test_legal_move(self):
+        """
+
+        checks that try_play plays a legal move and reports it as legal
+
+        :return:
+        """
+
+        game = sente.Game()
+
+        self.assertEqual(sente.move_status.LEGAL, game.try_play(4, 4))
+        self.assertEqual(sente.stone.BLACK, game.get_point(4, 4))
+        self.assertEqual(sente.stone.WHITE, game.get_active_player())
+
+    def test_illegal_moves(self):
+        """
+
+        checks that try_play reports why a move is illegal instead of raising an exception
+
+        :return:
+        """
+
+        game = sente.Game()
+
+        game.play(2, 3, sente.stone.BLACK)
+        game.play(3, 3, sente.stone.WHITE)
+
+        game.play(4, 3, sente.stone.BLACK)
+        game.play(1, 3, sente.stone.WHITE)
+
+        game.play(3, 2, sente.stone.BLACK)
+        game.play(2, 4, sente.stone.WHITE)
+
+        game.play(3, 4, sente.stone.BLACK)
+        game.play(2, 2, sente.stone.WHITE)
+
+        game.play(18, 18, sente.stone.BLACK)
+        game.play(3, 3, sente.stone.WHITE)  # take the Ko
+
+        self.assertEqual(sente.move_status.OFF_BOARD, game.try_play(0, 0))
+        self.assertEqual(sente.move_status.OFF_BOARD, game.try_play(20, 1))
+        self.assertEqual(sente.move_status.OCCUPIED_POINT, game.try_play(4, 3))
+        self.assertEqual(sente.move_status.WRONG_COLOR, game.try_play(10, 10, sente.stone.WHITE))
+        self.assertEqual(sente.move_status.KO_POINT, game.try_play(2, 3))
+
+        game.play(18, 1, sente.stone.BLACK)
+        game.play(1, 1, sente.stone.WHITE)
+
+        # (1, 2) has no liberties once it is played and captures nothing
+        self.assertEqual(sente.move_status.SELF_CAPTURE, game.try_play(1, 2))
+
+    def test_illegal_move_leaves_game_unchanged(self):
+        """
+
+        checks that a move rejected by try_play does not change the game
+
+        :return:
+        """
+
+        game = sente.Game()
+        game.play(4, 4)
+        game.pss()
+
+        start = game.get_hash()
+
+        self.assertEqual(sente.move_status.OCCUPIED_POINT, game.try_play(4, 4))
+
+        self.assertEqual(start, game.get_hash())
+        self.assertEqual(sente.stone.BLACK, game.get_active_player())
+        self.assertEqual(2, len(game.get_current_sequence()))
+
+        # the earlier pass still counts towards ending the game
+        game.pss()
+        self.assertTrue(game.is_over())
+
+    def test_superko(self):
+        """
+
+        checks that try_play reports superko violations
+
+        :return:
+        """
+
+        game = sente.Game(ko_rule=sente.ko_rule.POSITIONAL_SUPERKO)
+        IllegalMoveThrowsException.play_triple_ko(game)
+
+        self.assertEqual(sente.move_status.SUPERKO, game.try_play(14, 3))
+
+    def test_superko_clone(self):
+        """
+
+        checks that a game cloned without its history still remembers the positions that superko forbids
+
+        :return:
+        """
+
+        game = sente.Game(ko_rule=sente.ko_rule.POSITIONAL_SUPERKO)
+        IllegalMoveThrowsException.play_triple_ko(game)
+
+        clone = game.clone(history=False)
+
+        self.assertEqual(sente.move_status.SUPERKO, clone.try_play(14, 3))
+
+    def test_pass(self):
+        """
+
+        checks that passing with try_play is always legal
+
+        :return:
+        """
+
+        game = sente.Game()
+
+        self.assertEqual(sente.move_status.LEGAL, game.try_play(None))
+        self.assertEqual(sente.stone.WHITE, game.get_active_player())
@@ -87,3 +87,23 @@ class MoveTest(TestCase):
         self.assertEqual("B D5", str(self.move3))
         self.assertEqual("W D5", str(self.move4))
 
+    def test_transform(self):
+        """
+
+        checks to see if moves are rotated and reflected correctly
+
+        :return:
+        """
+
+        move = sente.Move(sente.stone.BLACK, 1, 2)
+
+        self.assertEqual(sente.Move(sente.stone.BLACK, 1, 2), move.transform(0, 9))
+        self.assertEqual(sente.Move(sente.stone.BLACK, 9, 2), move.transform(1, 9))
+        self.assertEqual(sente.Move(sente.stone.BLACK, 1, 8), move.transform(2, 9))
+        self.assertEqual(sente.Move(sente.stone.BLACK, 2, 1), move.transform(4, 9))
+        self.assertEqual(sente.Move(sente.stone.BLACK, 8, 1), move.transform(5, 9))
+
+        for symmetry in range(8):
+            self.assertEqual(move, move.transform(symmetry, 9).transform(symmetry, 9, inverse=True))
+
+        self.assertEqual(sente.moves.Pass(sente.stone.WHITE), sente.moves.Pass(sente.stone.WHITE).transform(3))
@@ -137,3 +137,218 @@ class TestNoDeadStones(TestCase):
         self.assertEqual(sente.stone.WHITE, game.get_winner())
         self.assertEqual(0, result[sente.BLACK])
         self.assertEqual(6.5, result[sente.WHITE])
+
+    def test_score_position(self):
+        """
+
+        tests to see if a position can be scored before the game is over
+
+        :return:
+        """
+
+        game = sente.Game(19, sente.CHINESE)
+        self.play_simple_game(game)
+
+        result = game.score_position()
+
+        self.assertFalse(game.is_over())
+        self.assertEqual(10, result[sente.BLACK])
+        self.assertEqual(17.5, result[sente.WHITE])
+
+        # ending the game gives the same score
+        self.end_game(game)
+        self.assertEqual(result[sente.BLACK], game.score()[sente.BLACK])
+        self.assertEqual(result[sente.WHITE], game.score()[sente.WHITE])
+
+    def test_score_position_tromp_taylor(self):
+        """
+
+        tests to see if Tromp-Taylor rules count the stones on the board
+
+        :return:
+        """
+
+        game = sente.Game(9, sente.rules.TROMP_TAYLOR)
+        game.play(5, 5)
+
+        result = game.score_position()
+
+        self.assertEqual(81, result[sente.BLACK])
+        self.assertEqual(7.5, result[sente.WHITE])
+
+    def test_score_position_clone(self):
+        """
+
+        tests to see if a game cloned without its history still counts the stones captured before it was cloned
+
+        :return:
+        """
+
+        game = sente.Game(19, sente.JAPANESE)
+        self.play_capture_stones_game(game)
+
+        clone = game.clone(history=False)
+
+        self.assertEqual(game.score_position()[sente.BLACK], clone.score_position()[sente.BLACK])
+        self.assertEqual(game.score_position()[sente.WHITE], clone.score_position()[sente.WHITE])
+
+
+class TestDeadStones(TestCase):
+
+    @staticmethod
+    def make_two_eyed_group(game):
+        """
+
+        places a black group with two eyes along the edge of a 5x5 board, with a dead white stone in one of the eyes
+
+        :param game: game to place the stones on
+        :return:
+        """
+
+        stones = {sente.Move(sente.stone.BLACK, 2, y) for y in range(1, 6)}
+        stones.add(sente.Move(sente.stone.BLACK, 1, 3))
+        stones.add(sente.Move(sente.stone.WHITE, 1, 1))
+
+        game.play(stones)
+
+    def test_pass_alive_area(self):
+        """
+
+        tests to see if Benson's algorithm finds the area of a group with two eyes
+
+        :return:
+        """
+
+        game = sente.Game(5)
+        self.make_two_eyed_group(game)
+
+        self.assertEqual(10, len(game.get_pass_alive_area(sente.stone.BLACK)))
+        self.assertEqual(0, len(game.get_pass_alive_area(sente.stone.WHITE)))
+
+    def test_one_eye_not_pass_alive(self):
+        """
+
+        tests to see if a group with only one eye is not pass-alive
+
+        :return:
+        """
+
+        game = sente.Game(5)
+        game.play({sente.Move(sente.stone.BLACK, 2, y) for y in range(1, 6)})
+
+        self.assertEqual(0, len(game.get_pass_alive_area(sente.stone.BLACK)))
+
+    def test_find_dead_stones(self):
+        """
+
+        tests to see if a stone inside pass-alive territory is found to be dead
+
+        :return:
+        """
+
+        game = sente.Game(5)
+        self.make_two_eyed_group(game)
+
+        self.assertEqual([sente.Move(sente.stone.WHITE, 1, 1)], game.find_dead_stones())
+
+    def test_score_dead_stones(self):
+        """
+
+        tests to see if dead stones are taken off the board when scoring
+
+        :return:
+        """
+
+        game = sente.Game(5, sente.CHINESE)
+        self.make_two_eyed_group(game)
+
+        result = game.score_position()
+
+        self.assertEqual(23, result[sente.BLACK])
+        self.assertEqual(8.5, result[sente.WHITE])
+
+        game.set_dead_stones(game.find_dead_stones())
+        result = game.score_position()
+
+        self.assertEqual(25, result[sente.BLACK])
+        self.assertEqual(7.5, result[sente.WHITE])
+
+    def test_score_dead_stones_japanese(self):
+        """
+
+        tests to see if dead stones are counted as prisoners under japanese rules
+
+        :return:
+        """
+
+        game = sente.Game(5, sente.JAPANESE)
+        self.make_two_eyed_group(game)
+
+        game.set_dead_stones([sente.Move(sente.stone.WHITE, 1, 1)])
+        result = game.score_position()
+
+        self.assertEqual(19, result[sente.BLACK])
+        self.assertEqual(5.5, result[sente.WHITE])
+
+    def test_dead_stone_estimator(self):
+        """
+
+        tests to see if an estimator function can choose the dead stones of a finished game
+
+        :return:
+        """
+
+        game = sente.Game(5, sente.CHINESE)
+        self.make_two_eyed_group(game)
+
+        game.pss()
+        game.pss()
+
+        game.set_dead_stones(lambda finished: finished.find_dead_stones())
+
+        self.assertEqual(1, len(game.get_dead_stones()))
+        self.assertEqual(25, game.score()[sente.BLACK])
+        self.assertEqual(sente.stone.BLACK, game.get_winner())
+
+    def test_dead_stones_from_territory(self):
+        """
+
+        tests to see if dead stones can be read from the territory properties of an SGF file
+
+        :return:
+        """
+
+        game = sente.sgf.loads("(;FF[4]GM[1]SZ[5]AB[ba][bb][bc][bd][be][ac]AW[aa]TB[aa:ab][ad][ae])")
+        game.set_dead_stones_from_territory()
+
+        self.assertEqual([sente.Move(sente.stone.WHITE, 1, 1)], game.get_dead_stones())
+        self.assertEqual(25, game.score_position()[sente.BLACK])
+
+    def test_mark_empty_point(self):
+        """
+
+        tests to see if marking an empty point as dead raises an exception
+
+        :return:
+        """
+
+        game = sente.Game(5)
+
+        with self.assertRaises(ValueError):
+            game.set_dead_stones([sente.Move(sente.stone.BLACK, 3, 3)])
+
+    def test_marks_cleared_by_move(self):
+        """
+
+        tests to see if dead stone marks are ignored once the board changes
+
+        :return:
+        """
+
+        game = sente.Game(5)
+        self.make_two_eyed_group(game)
+
+        game.set_dead_stones(game.find_dead_stones())
+        game.play(5, 5, game.get_active_player())
+
+        self.assertEqual([], game.get_dead_stones())